@@ -0,0 +1,98 @@
+#include "Allocations.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<uint64_t> count;
+
+	void * Allocate(std::size_t const size)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		if (void * const ptr = std::malloc(size == 0 ? 1 : size))
+		{
+			return ptr;
+		}
+		throw std::bad_alloc();
+	}
+
+	// the default memory resource allocates with the alignment overloads
+	void * Allocate(std::size_t const size, std::align_val_t const alignment)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		auto const align = static_cast<std::size_t>(alignment);
+		if (void * const ptr = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+		{
+			return ptr;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+uint64_t Allocations::Count()
+{
+	return count.load(std::memory_order_relaxed);
+}
+
+void * operator new(std::size_t const size)
+{
+	return Allocate(size);
+}
+
+void * operator new[](std::size_t const size)
+{
+	return Allocate(size);
+}
+
+void operator delete(void * const ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * const ptr, std::size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr, std::size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
+
+void * operator new(std::size_t const size, std::align_val_t const alignment)
+{
+	return Allocate(size, alignment);
+}
+
+void * operator new[](std::size_t const size, std::align_val_t const alignment)
+{
+	return Allocate(size, alignment);
+}
+
+void operator delete(void * const ptr, std::align_val_t /*alignment*/) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr, std::align_val_t /*alignment*/) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * const ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	std::free(ptr);
+}
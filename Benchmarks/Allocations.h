@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// global operator new is replaced in Allocations.cpp to count heap allocations, for per element figures in benchmarks
+namespace Allocations
+{
+	[[nodiscard]] uint64_t Count();
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <string>
+
+namespace Documents
+{
+	// records with attributes, text, comments, cdata and entities, touches every engine state
+	inline std::string Mixed(size_t const records)
+	{
+		std::string xml = R"(<?xml version="1.0" encoding="UTF-8" ?>
+<!DOCTYPE feed>
+<!-- generated -->
+<feed xmlns:x='urn:x' version="1.0">
+)";
+		for (size_t i = 0; i < records; ++i)
+		{
+			auto const id = std::to_string(i);
+			xml += "\t<item id='" + id + "' x:kind=\"record\" >\n";
+			xml += "\t\t<title>Item number " + id + " &amp; some descriptive text</title>\n";
+			xml += "\t\t<x:price currency = 'GBP'>" + id + ".99</x:price>\n";
+			xml += "\t\t<!-- comment for " + id + " -->\n";
+			xml += "\t\t<data><![CDATA[<raw>" + id + "</raw> ]] ]]></data>\n";
+			xml += "\t\t<empty/>\n";
+			xml += "\t</item >\n";
+		}
+		xml += "</feed>\n";
+		return xml;
+	}
+
+	// large text nodes and long attribute values, like base64 payloads
+	inline std::string TextHeavy(size_t const records)
+	{
+		std::string const payload = [&]
+		{
+			std::string value;
+			constexpr size_t payloadSize = 4096;
+			constexpr size_t lineLength = 76;
+			constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (size_t i = 0; i < payloadSize; ++i)
+			{
+				value += alphabet[(i * 7) % alphabet.size()];
+				if (i % lineLength == lineLength - 1)
+				{
+					value += '\n';
+				}
+			}
+			return value;
+		}();
+
+		std::string xml = "<feed>\n";
+		for (size_t i = 0; i < records; ++i)
+		{
+			xml += "\t<item digest='" + payload.substr(0, 64) + "'>" + payload + "</item>\n";
+			xml += "\t<!-- " + payload.substr(0, 256) + " -->\n";
+		}
+		xml += "</feed>\n";
+		return xml;
+	}
+
+	// nesting far deeper than typical documents, repeated so the total size is comparable
+	inline std::string Deep(size_t const depth, size_t const repeats)
+	{
+		std::string xml = "<root>";
+		for (size_t r = 0; r < repeats; ++r)
+		{
+			for (size_t i = 0; i < depth; ++i)
+			{
+				xml += "<level n='" + std::to_string(i) + "'>";
+			}
+			xml += "leaf";
+			for (size_t i = 0; i < depth; ++i)
+			{
+				xml += "</level>";
+			}
+		}
+		xml += "</root>\n";
+		return xml;
+	}
+
+	// one parent with a very large number of small children
+	inline std::string Wide(size_t const children)
+	{
+		std::string xml = "<root>\n";
+		for (size_t i = 0; i < children; ++i)
+		{
+			xml += "<c/><d>" + std::to_string(i) + "</d>";
+		}
+		xml += "</root>\n";
+		return xml;
+	}
+
+	// many attributes per element, some with entities, little text
+	inline std::string AttributeHeavy(size_t const records)
+	{
+		std::string xml = "<rows>\n";
+		for (size_t i = 0; i < records; ++i)
+		{
+			auto const id = std::to_string(i);
+			xml += "\t<row id='" + id + "' name=\"row " + id + "\" a='1' b='2' c='three' d='&amp;four' e=\"5.5\" f='x&lt;y' g='seven' h='8'"
+						 " i='nine' j='10' k='eleven' l='12'/>\n";
+		}
+		xml += "</rows>\n";
+		return xml;
+	}
+
+	// text and names outside ASCII, two, three and four byte sequences
+	inline std::string International(size_t const records)
+	{
+		std::string xml = "<feed>\n";
+		for (size_t i = 0; i < records; ++i)
+		{
+			auto const id = std::to_string(i);
+			xml += "\t<entr\xC3\xA9" "e id='" + id + "' devise='\xE2\x82\xAC'>\n";
+			xml += "\t\t<titre>Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9" "e num\xC3\xA9ro " + id + "</titre>\n";
+			xml += "\t\t<text>\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88 \xF0\x9F\x98\x80</text>\n";
+			xml += "\t</entr\xC3\xA9" "e>\n";
+		}
+		xml += "</feed>\n";
+		return xml;
+	}
+
+	// soap envelope with prefixed elements and attributes throughout
+	inline std::string Soap(size_t const records)
+	{
+		std::string xml = R"(<?xml version="1.0"?>
+<soap:Envelope xmlns:soap="http://www.w3.org/2003/05/soap-envelope" xmlns:xsi="http://www.w3.org/2001/XMLSchema-instance"
+	xmlns:xsd="http://www.w3.org/2001/XMLSchema" soap:encodingStyle="http://www.w3.org/2003/05/soap-encoding">
+<soap:Header><wsa:Action xmlns:wsa="http://www.w3.org/2005/08/addressing">urn:GetQuotes</wsa:Action></soap:Header>
+<soap:Body>
+<m:GetQuotesResponse xmlns:m="urn:example:quotes">
+)";
+		for (size_t i = 0; i < records; ++i)
+		{
+			auto const id = std::to_string(i);
+			xml += "\t<m:Quote m:id='" + id + "' xsi:type='m:QuoteType'>\n";
+			xml += "\t\t<m:Symbol xsi:type='xsd:string'>SYM" + id + "</m:Symbol>\n";
+			xml += "\t\t<m:Price xsi:type='xsd:decimal' m:currency='GBP'>" + id + ".25</m:Price>\n";
+			xml += "\t\t<ext:Note xmlns:ext='urn:example:ext' ext:lang='en'>note " + id + "</ext:Note>\n";
+			xml += "\t</m:Quote>\n";
+		}
+		xml += "</m:GetQuotesResponse>\n</soap:Body>\n</soap:Envelope>\n";
+		return xml;
+	}
+
+	// schema with a default namespace plus a prefixed target namespace
+	inline std::string Xsd(size_t const records)
+	{
+		std::string xml = R"(<?xml version="1.0"?>
+<xs:schema xmlns:xs="http://www.w3.org/2001/XMLSchema" xmlns="urn:example:types" xmlns:tns="urn:example:types"
+	targetNamespace="urn:example:types" elementFormDefault="qualified">
+)";
+		for (size_t i = 0; i < records; ++i)
+		{
+			auto const id = std::to_string(i);
+			xml += "\t<xs:complexType name='Type" + id + "'>\n\t\t<xs:sequence>\n";
+			xml += "\t\t\t<xs:element name='code' type='xs:string' minOccurs='0'/>\n";
+			xml += "\t\t\t<xs:element name='next' type='tns:Type" + id + "' maxOccurs='unbounded'/>\n";
+			xml += "\t\t</xs:sequence>\n\t\t<xs:attribute name='id' type='xs:int' use='required'/>\n\t</xs:complexType>\n";
+			xml += "\t<xs:element name='item" + id + "' type='tns:Type" + id + "'><annotation/></xs:element>\n";
+		}
+		xml += "</xs:schema>\n";
+		return xml;
+	}
+}
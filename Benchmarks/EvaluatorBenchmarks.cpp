@@ -0,0 +1,82 @@
+#include <GLib/Eval/Evaluator.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../Coverage/LineCover.h"
+
+#include "../Coverage/Line.h"
+
+// a property of each line read inside an each loop, by name, by a split path and by a binding
+namespace
+{
+	constexpr size_t LineCount = 2000;
+
+	std::vector<Line> const & Lines()
+	{
+		static std::vector<Line> const lines = []
+		{
+			std::vector<Line> values;
+			for (unsigned int i = 1; i <= LineCount; ++i)
+			{
+				values.push_back({"text", i, std::to_string(i), LineCover::Covered, false});
+			}
+			return values;
+		}();
+		return lines;
+	}
+
+	template <typename Read>
+	void Loop(benchmark::State & state, GLib::Eval::Evaluator & eval, Read const & read)
+	{
+		eval.SetCollection("lines", Lines());
+		for (auto _ : state)
+		{
+			eval.ForEach("lines",
+									 [&](GLib::Eval::ValueBase const & line)
+									 {
+										 eval.Push("line", line);
+										 benchmark::DoNotOptimize(read());
+										 eval.Pop("line");
+									 });
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LineCount));
+	}
+
+	void EvaluateName(benchmark::State & state)
+	{
+		GLib::Eval::Evaluator eval;
+		Loop(state, eval, [&] { return eval.Evaluate("line.paddedNumber"); });
+	}
+
+	void EvaluatePath(benchmark::State & state)
+	{
+		GLib::Eval::Evaluator eval;
+		GLib::Eval::Path const path {"line", "paddedNumber"};
+		Loop(state, eval, [&] { return eval.Evaluate(path); });
+	}
+
+	// as a compiled template renders, the loop variable pushed by handle
+	void EvaluateBinding(benchmark::State & state)
+	{
+		GLib::Eval::Evaluator eval;
+		eval.SetCollection("lines", Lines());
+		GLib::Eval::Binding const lines = eval.Bind({"lines"});
+		GLib::Eval::Binding const binding = eval.Bind({"line", "paddedNumber"});
+		GLib::Eval::Variable const variable = eval.GetVariable("line");
+		for (auto _ : state)
+		{
+			eval.ForEach(lines,
+									 [&](GLib::Eval::ValueBase const & line)
+									 {
+										 eval.Push(variable, line);
+										 benchmark::DoNotOptimize(eval.Evaluate(binding));
+										 eval.Pop(variable);
+									 });
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LineCount));
+	}
+}
+
+BENCHMARK(EvaluateName);
+BENCHMARK(EvaluatePath);
+BENCHMARK(EvaluateBinding);
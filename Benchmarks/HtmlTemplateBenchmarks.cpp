@@ -0,0 +1,168 @@
+#include <GLib/Html/RenderBatch.h>
+
+#include <benchmark/benchmark.h>
+
+#include "../Coverage/LineCover.h"
+
+#include "../Coverage/Chunk.h"
+#include "../Coverage/CoverageLevel.h"
+#include "../Coverage/Line.h"
+
+#include <fstream>
+#include <sstream>
+
+// the coverage report source file page, rendered from the xml each time and from a compiled template
+namespace
+{
+	constexpr size_t LineCount = 2000;
+
+	std::string const & FileTemplate()
+	{
+		static std::string const xml = []
+		{
+			std::ifstream const in(COVERAGE_TEMPLATES "/file.html");
+			if (!in)
+			{
+				throw std::runtime_error("Unable to open file.html");
+			}
+			std::ostringstream buffer;
+			buffer << in.rdbuf();
+			return buffer.str();
+		}();
+		return xml;
+	}
+
+	struct Source
+	{
+		std::vector<Line> lines;
+		std::vector<Chunk> chunks;
+	};
+
+	Source const & SourceFile()
+	{
+		static Source const source = []
+		{
+			Source value;
+			for (unsigned int i = 1; i <= LineCount; ++i)
+			{
+				auto const cover = static_cast<LineCover>(i % 7 % 3);
+				std::string text = "\t<span class=\"k\">auto</span> value" + std::to_string(i) + " = Call(&quot;text&quot;, " + std::to_string(i) + ");";
+				auto padded = std::to_string(i);
+				padded.insert(0, 4 - padded.size(), ' ');
+				value.lines.push_back({std::move(text), i, std::move(padded), cover, i % 40 == 0});
+			}
+			for (auto const & line : value.lines)
+			{
+				if (value.chunks.empty() || value.chunks.back().Cover != line.Cover)
+				{
+					value.chunks.push_back({line.Cover, 0});
+				}
+				value.chunks.back().Size += 100.0F / LineCount;
+			}
+			return value;
+		}();
+		return source;
+	}
+
+	void SetValues(GLib::Eval::Evaluator & eval)
+	{
+		Source const & source = SourceFile();
+		eval.Set("title", std::string {"Dir/File.cpp"});
+		eval.Set("testName", std::string {"Benchmark"});
+		eval.Set("time", std::string {"19 Sep 2019, 14:42:43 (+0100)"});
+		eval.Set("parent", std::string {"Dir"});
+		eval.Set("fileName", std::string {"File.cpp"});
+		eval.Set("styleSheet", std::string {"../coverage.css"});
+		eval.Set("coverageStyle", CoverageLevel::Amber);
+		eval.Set("coveredLines", 1400U);
+		eval.Set("coverableLines", 2000U);
+		eval.Set("coveragePercent", 70U);
+		eval.Set("coveredFunctions", 20U);
+		eval.Set("coverableFunctions", 50U);
+		eval.Set("coverageFunctionsPercent", 40U);
+		eval.Set("coverageFunctionsStyle", CoverageLevel::Red);
+		eval.Set("index", std::string {"../index.html"});
+		eval.SetCollection("lines", source.lines);
+		eval.SetCollection("chunks", source.chunks);
+	}
+
+	void TemplateParsePerRender(benchmark::State & state)
+	{
+		std::string const & xml = FileTemplate();
+		GLib::Eval::Evaluator eval;
+		SetValues(eval);
+		size_t bytes {};
+		for (auto _ : state)
+		{
+			std::ostringstream out;
+			GLib::Html::Generate(eval, xml, out);
+			bytes += out.view().size();
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LineCount));
+	}
+
+	void TemplateCompiled(benchmark::State & state)
+	{
+		GLib::Html::CompiledTemplate const compiled {FileTemplate()};
+		GLib::Eval::Evaluator eval;
+		SetValues(eval);
+		size_t bytes {};
+		for (auto _ : state)
+		{
+			std::ostringstream out;
+			GLib::Html::Generate(eval, compiled, out);
+			bytes += out.view().size();
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LineCount));
+	}
+
+	// into an appender whose blocks are only counted, as a file target would receive them
+	void TemplateCompiledAppender(benchmark::State & state)
+	{
+		GLib::Html::CompiledTemplate const compiled {FileTemplate()};
+		GLib::Eval::Evaluator eval;
+		SetValues(eval);
+		size_t bytes {};
+		GLib::Util::Appender out {[&](std::string_view const data) { bytes += data.size(); }};
+		for (auto _ : state)
+		{
+			GLib::Html::Generate(eval, compiled, out);
+			out.Flush();
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * LineCount));
+	}
+
+	// a report's worth of source file pages written to disk, arg is the thread count
+	void TemplateRenderBatch(benchmark::State & state)
+	{
+		constexpr size_t PageCount = 32;
+		GLib::Html::CompiledTemplate const compiled {FileTemplate()};
+		auto const directory = std::filesystem::temp_directory_path() / "GLibRenderBatch";
+		std::vector<GLib::Html::RenderJob> jobs;
+		for (size_t i = 0; i < PageCount; ++i)
+		{
+			jobs.push_back({SetValues, {{&compiled, directory / ("File" + std::to_string(i) + ".html")}}});
+		}
+
+		auto const threads = static_cast<size_t>(state.range(0));
+		size_t bytes {};
+		for (auto _ : state)
+		{
+			for (auto const & timing : GLib::Html::RenderBatch(jobs, threads))
+			{
+				bytes += timing.Bytes;
+			}
+		}
+		std::filesystem::remove_all(directory);
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * PageCount));
+	}
+}
+
+BENCHMARK(TemplateParsePerRender);
+BENCHMARK(TemplateCompiled);
+BENCHMARK(TemplateCompiledAppender);
+BENCHMARK(TemplateRenderBatch)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
@@ -0,0 +1,68 @@
+#include <GLib/Xml/Iterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+#include <array>
+
+namespace
+{
+	constexpr size_t RecordCount = 5000;
+
+	std::string const & Xml()
+	{
+		static std::string const xml = Documents::Soap(RecordCount);
+		return xml;
+	}
+
+	// three lookups per element, as a template processor does for its action attributes
+	constexpr std::array<std::string_view, 3> Names {"id", "type", "missing"};
+
+	void AttributeLookupScan(benchmark::State & state)
+	{
+		std::string_view const xml = Xml();
+		for (auto _ : state)
+		{
+			size_t found {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				for (auto const name : Names)
+				{
+					for (auto const & attribute : element.GetAttributes())
+					{
+						if (attribute.Name == name)
+						{
+							++found;
+							break;
+						}
+					}
+				}
+			}
+			benchmark::DoNotOptimize(found);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void AttributeLookupIndex(benchmark::State & state)
+	{
+		std::string_view const xml = Xml();
+		for (auto _ : state)
+		{
+			size_t found {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				auto const & index = element.IndexedAttributes();
+				for (auto const name : Names)
+				{
+					found += index.Find(name, {}) != nullptr ? 1 : 0;
+				}
+			}
+			benchmark::DoNotOptimize(found);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+}
+
+BENCHMARK(AttributeLookupScan);
+BENCHMARK(AttributeLookupIndex);
@@ -0,0 +1,317 @@
+#include <GLib/Xml/Binding.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+// the Mixed feed read into structs, by a schema and by a hand written consumer comparing names
+namespace
+{
+	constexpr size_t RecordCount = 20000;
+
+	std::string const & Document()
+	{
+		static std::string const xml = Documents::Mixed(RecordCount);
+		return xml;
+	}
+
+	struct Price
+	{
+		std::string currency;
+		double value {};
+	};
+
+	struct Item
+	{
+		int id {};
+		std::string kind;
+		std::string title;
+		Price price;
+		std::string data;
+	};
+
+	struct Feed
+	{
+		std::string version;
+		std::vector<Item> items;
+	};
+
+	constexpr std::string_view x = "urn:x";
+
+	constexpr GLib::Xml::Bind::Schema priceSchema {GLib::Xml::Bind::Attribute("currency", &Price::currency),
+																								 GLib::Xml::Bind::Text(&Price::value)};
+
+	constexpr GLib::Xml::Bind::Schema itemSchema {
+		GLib::Xml::Bind::Attribute("id", &Item::id), GLib::Xml::Bind::Attribute({x, "kind"}, &Item::kind),
+		GLib::Xml::Bind::Child("title", &Item::title), GLib::Xml::Bind::Child({x, "price"}, &Item::price, priceSchema),
+		GLib::Xml::Bind::Child("data", &Item::data)};
+
+	constexpr GLib::Xml::Bind::Schema feedSchema {GLib::Xml::Bind::Attribute("version", &Feed::version),
+																								GLib::Xml::Bind::Child("item", &Feed::items, itemSchema)};
+
+	// fourteen attributes per row, where a chain of comparisons is long
+	struct Row
+	{
+		int id {};
+		std::string name;
+		int a {};
+		int b {};
+		std::string c;
+		std::string d;
+		double e {};
+		std::string f;
+		std::string g;
+		int h {};
+		std::string i;
+		int j {};
+		std::string k;
+		int l {};
+	};
+
+	struct Rows
+	{
+		std::vector<Row> rows;
+	};
+
+	constexpr GLib::Xml::Bind::Schema rowSchema {GLib::Xml::Bind::Attribute("id", &Row::id),
+													GLib::Xml::Bind::Attribute("name", &Row::name),
+													GLib::Xml::Bind::Attribute("a", &Row::a),
+													GLib::Xml::Bind::Attribute("b", &Row::b),
+													GLib::Xml::Bind::Attribute("c", &Row::c),
+													GLib::Xml::Bind::Attribute("d", &Row::d),
+													GLib::Xml::Bind::Attribute("e", &Row::e),
+													GLib::Xml::Bind::Attribute("f", &Row::f),
+													GLib::Xml::Bind::Attribute("g", &Row::g),
+													GLib::Xml::Bind::Attribute("h", &Row::h),
+													GLib::Xml::Bind::Attribute("i", &Row::i),
+													GLib::Xml::Bind::Attribute("j", &Row::j),
+													GLib::Xml::Bind::Attribute("k", &Row::k),
+													GLib::Xml::Bind::Attribute("l", &Row::l)};
+
+	constexpr GLib::Xml::Bind::Schema rowsSchema {GLib::Xml::Bind::Child("row", &Rows::rows, rowSchema)};
+
+	std::string const & RowsDocument()
+	{
+		static std::string const xml = Documents::AttributeHeavy(RecordCount);
+		return xml;
+	}
+
+	template <typename T>
+	void Number(std::string_view const value, T & out)
+	{
+		std::from_chars(value.data(), value.data() + value.size(), out);
+	}
+
+	// the way consumers were written on the iterator, names compared by string as each element arrives
+	Feed HandWritten(std::string_view const xml)
+	{
+		Feed feed;
+		std::string buffer;
+		std::string_view current; // the child whose text is expected
+		for (auto const & element : GLib::Xml::Holder {xml})
+		{
+			switch (element.Type())
+			{
+				case GLib::Xml::ElementType::Open:
+				case GLib::Xml::ElementType::Empty:
+				{
+					current = {};
+					if (element.Name() == "feed" && element.NameSpace().empty())
+					{
+						for (auto const & attribute : element.GetAttributes())
+						{
+							if (attribute.Name == "version" && attribute.NameSpace.empty())
+							{
+								feed.version = attribute.DecodedValue(buffer);
+							}
+						}
+					}
+					else if (element.Name() == "item" && element.NameSpace().empty())
+					{
+						Item & item = feed.items.emplace_back();
+						for (auto const & attribute : element.GetAttributes())
+						{
+							if (attribute.Name == "id" && attribute.NameSpace.empty())
+							{
+								Number(attribute.Value, item.id);
+							}
+							else if (attribute.Name == "kind" && attribute.NameSpace == x)
+							{
+								item.kind = attribute.DecodedValue(buffer);
+							}
+						}
+					}
+					else if (element.Name() == "price" && element.NameSpace() == x)
+					{
+						for (auto const & attribute : element.GetAttributes())
+						{
+							if (attribute.Name == "currency" && attribute.NameSpace.empty())
+							{
+								feed.items.back().price.currency = attribute.DecodedValue(buffer);
+							}
+						}
+						current = "price";
+					}
+					else if ((element.Name() == "title" || element.Name() == "data") && element.NameSpace().empty())
+					{
+						current = element.Name();
+					}
+					break;
+				}
+
+				case GLib::Xml::ElementType::Text:
+				{
+					if (current == "title")
+					{
+						feed.items.back().title = element.DecodedText(buffer);
+					}
+					else if (current == "data")
+					{
+						feed.items.back().data = element.DecodedText(buffer);
+					}
+					else if (current == "price")
+					{
+						Number(element.Text(), feed.items.back().price.value);
+					}
+					break;
+				}
+
+				default:
+				{
+					current = {};
+					break;
+				}
+			}
+		}
+		return feed;
+	}
+
+	Rows HandWrittenRows(std::string_view const xml)
+	{
+		Rows rows;
+		std::string buffer;
+		for (auto const & element : GLib::Xml::Holder {xml})
+		{
+			if (element.Type() != GLib::Xml::ElementType::Empty || element.Name() != "row" || !element.NameSpace().empty())
+			{
+				continue;
+			}
+
+			Row & row = rows.rows.emplace_back();
+			for (auto const & attribute : element.GetAttributes())
+			{
+				if (!attribute.NameSpace.empty())
+				{
+					continue;
+				}
+				auto const value = attribute.DecodedValue(buffer);
+				if (attribute.Name == "id")
+				{
+					Number(value, row.id);
+				}
+				else if (attribute.Name == "name")
+				{
+					row.name = value;
+				}
+				else if (attribute.Name == "a")
+				{
+					Number(value, row.a);
+				}
+				else if (attribute.Name == "b")
+				{
+					Number(value, row.b);
+				}
+				else if (attribute.Name == "c")
+				{
+					row.c = value;
+				}
+				else if (attribute.Name == "d")
+				{
+					row.d = value;
+				}
+				else if (attribute.Name == "e")
+				{
+					Number(value, row.e);
+				}
+				else if (attribute.Name == "f")
+				{
+					row.f = value;
+				}
+				else if (attribute.Name == "g")
+				{
+					row.g = value;
+				}
+				else if (attribute.Name == "h")
+				{
+					Number(value, row.h);
+				}
+				else if (attribute.Name == "i")
+				{
+					row.i = value;
+				}
+				else if (attribute.Name == "j")
+				{
+					Number(value, row.j);
+				}
+				else if (attribute.Name == "k")
+				{
+					row.k = value;
+				}
+				else if (attribute.Name == "l")
+				{
+					Number(value, row.l);
+				}
+			}
+		}
+		return rows;
+	}
+
+	void BindingHandWritten(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(HandWritten(xml));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordCount));
+	}
+
+	void BindingSchema(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(GLib::Xml::Bind::Read("feed", feedSchema, GLib::Xml::Holder {xml}));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordCount));
+	}
+
+	void BindingRowsHandWritten(benchmark::State & state)
+	{
+		std::string_view const xml = RowsDocument();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(HandWrittenRows(xml));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordCount));
+	}
+
+	void BindingRowsSchema(benchmark::State & state)
+	{
+		std::string_view const xml = RowsDocument();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(GLib::Xml::Bind::Read("rows", rowsSchema, GLib::Xml::Holder {xml}));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * RecordCount));
+	}
+}
+
+BENCHMARK(BindingHandWritten);
+BENCHMARK(BindingSchema);
+BENCHMARK(BindingRowsHandWritten);
+BENCHMARK(BindingRowsSchema);
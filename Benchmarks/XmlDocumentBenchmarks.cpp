@@ -0,0 +1,73 @@
+#include <GLib/Xml/Document.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+namespace
+{
+	constexpr size_t RecordCount = 20000;
+
+	std::string const & Xml()
+	{
+		static std::string const xml = Documents::Mixed(RecordCount);
+		return xml;
+	}
+
+	void DocumentBuild(benchmark::State & state)
+	{
+		std::string_view const xml = Xml();
+		double bytesPerNode {};
+		for (auto _ : state)
+		{
+			GLib::Xml::Document const doc {xml};
+			bytesPerNode = doc.BytesPerNode();
+			benchmark::DoNotOptimize(doc);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.counters["BytesPerNode"] = bytesPerNode;
+	}
+
+	// the price of every item, first by re-iterating the source, then through the tree
+	void DocumentQueryIterator(benchmark::State & state)
+	{
+		std::string_view const xml = Xml();
+		for (auto _ : state)
+		{
+			size_t count {};
+			bool inPrice {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				if (element.Type() == GLib::Xml::ElementType::Open || element.Type() == GLib::Xml::ElementType::Close)
+				{
+					inPrice = element.Type() == GLib::Xml::ElementType::Open && element.Name() == "price";
+				}
+				else if (inPrice && element.Type() == GLib::Xml::ElementType::Text)
+				{
+					count += element.Text().size();
+				}
+			}
+			benchmark::DoNotOptimize(count);
+		}
+	}
+
+	void DocumentQueryTree(benchmark::State & state)
+	{
+		GLib::Xml::Document const doc {Xml()};
+		for (auto _ : state)
+		{
+			size_t count {};
+			auto const root = doc.Root();
+			for (auto item = doc.Child(root, "item"); item != GLib::Xml::Document::None; item = doc.NextNamed(item))
+			{
+				auto const price = doc.Child(item, "price", "urn:x");
+				count += doc.Get(doc.Get(price).FirstChild()).Text().size();
+			}
+			benchmark::DoNotOptimize(count);
+		}
+	}
+}
+
+BENCHMARK(DocumentBuild);
+BENCHMARK(DocumentQueryIterator);
+BENCHMARK(DocumentQueryTree);
@@ -0,0 +1,133 @@
+#include <GLib/Xml/Utils.h>
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+namespace Legacy
+{
+	// the five finds per step Escape that the single pass version replaced
+	inline std::ostream & Escape(std::string_view value, std::ostream & out)
+	{
+		for (size_t startPos = 0;;)
+		{
+			std::string_view replacement;
+			size_t pos = std::string::npos;
+			for (auto const & [escaped, unescaped] : GLib::Xml::Utils::Entities)
+			{
+				size_t const find = value.find(unescaped, startPos);
+				if (find != std::string::npos && find < pos)
+				{
+					pos = find;
+					replacement = escaped;
+				}
+			}
+			if (pos == std::string::npos)
+			{
+				out << value.substr(startPos, value.size() - startPos) << replacement;
+				break;
+			}
+			out << value.substr(startPos, pos - startPos) << replacement;
+			startPos = pos + 1;
+		}
+		return out;
+	}
+}
+
+namespace
+{
+	constexpr size_t ValueSize = 4096;
+
+	std::string Repeat(std::string_view const value)
+	{
+		std::string result;
+		while (result.size() < ValueSize)
+		{
+			result += value;
+		}
+		return result;
+	}
+
+	std::string const & Clean()
+	{
+		static std::string const value = Repeat("int main(int argc, char * argv[]) { return Function(argc) + 1; }\n");
+		return value;
+	}
+
+	std::string const & Dense()
+	{
+		static std::string const value = Repeat("if (a < b && c > d) s = \"x\" + 'y';\n");
+		return value;
+	}
+
+	void LegacyStream(benchmark::State & state, std::string const & value)
+	{
+		for (auto _ : state)
+		{
+			std::ostringstream stm;
+			Legacy::Escape(value, stm);
+			benchmark::DoNotOptimize(stm);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+	}
+
+	void SinglePassStream(benchmark::State & state, std::string const & value)
+	{
+		for (auto _ : state)
+		{
+			std::ostringstream stm;
+			GLib::Xml::Utils::Escape(value, stm);
+			benchmark::DoNotOptimize(stm);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+	}
+
+	void SinglePassBuffer(benchmark::State & state, std::string const & value)
+	{
+		std::string buffer;
+		for (auto _ : state)
+		{
+			buffer.clear();
+			GLib::Xml::Utils::Escape(value, buffer);
+			benchmark::DoNotOptimize(buffer);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+	}
+
+	void EscapeLegacyClean(benchmark::State & state)
+	{
+		LegacyStream(state, Clean());
+	}
+
+	void EscapeLegacyDense(benchmark::State & state)
+	{
+		LegacyStream(state, Dense());
+	}
+
+	void EscapeStreamClean(benchmark::State & state)
+	{
+		SinglePassStream(state, Clean());
+	}
+
+	void EscapeStreamDense(benchmark::State & state)
+	{
+		SinglePassStream(state, Dense());
+	}
+
+	void EscapeBufferClean(benchmark::State & state)
+	{
+		SinglePassBuffer(state, Clean());
+	}
+
+	void EscapeBufferDense(benchmark::State & state)
+	{
+		SinglePassBuffer(state, Dense());
+	}
+}
+
+BENCHMARK(EscapeLegacyClean);
+BENCHMARK(EscapeLegacyDense);
+BENCHMARK(EscapeStreamClean);
+BENCHMARK(EscapeStreamDense);
+BENCHMARK(EscapeBufferClean);
+BENCHMARK(EscapeBufferDense);
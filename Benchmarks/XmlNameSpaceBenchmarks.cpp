@@ -0,0 +1,94 @@
+#include <GLib/Xml/AttributeIterator.h>
+#include <GLib/Xml/Iterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+#include "LegacyNameSpaceManager.h"
+
+#include <array>
+
+namespace
+{
+	constexpr size_t RecordCount = 5000;
+
+	constexpr std::array<std::pair<std::string_view, std::string_view>, 6> Declarations {{
+		{"xmlns:soap", "http://www.w3.org/2003/05/soap-envelope"},
+		{"xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance"},
+		{"xmlns:xsd", "http://www.w3.org/2001/XMLSchema"},
+		{"xmlns:wsa", "http://www.w3.org/2005/08/addressing"},
+		{"xmlns:m", "urn:example:quotes"},
+		{"xmlns:ext", "urn:example:ext"},
+	}};
+
+	constexpr std::array<std::string_view, 8> Names {"soap:Body", "m:Quote", "m:id", "xsi:type", "m:Symbol", "m:Price", "m:currency", "ext:lang"};
+
+	// push a soap like scope then normalise element and attribute names, with one element scoped declaration per pass
+	template <typename Manager>
+	void Lookup(benchmark::State & state)
+	{
+		Manager manager;
+		for (auto const & [name, value] : Declarations)
+		{
+			manager.Push(name, value, 0);
+		}
+
+		for (auto _ : state)
+		{
+			manager.Push("xmlns:ext", "urn:example:ext2", 1);
+			for (auto const name : Names)
+			{
+				benchmark::DoNotOptimize(manager.Normalise(name));
+			}
+			manager.Pop(1);
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * Names.size()));
+	}
+
+	void LegacyNameSpaceLookup(benchmark::State & state)
+	{
+		Lookup<Legacy::NameSpaceManager>(state);
+	}
+
+	void FlatNameSpaceLookup(benchmark::State & state)
+	{
+		Lookup<GLib::Xml::NameSpaceManager>(state);
+	}
+
+	void Iterate(benchmark::State & state, std::string_view const xml)
+	{
+		for (auto _ : state)
+		{
+			size_t count {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				benchmark::DoNotOptimize(element.NameSpace());
+				for (auto const & attribute : element.GetAttributes())
+				{
+					benchmark::DoNotOptimize(attribute.NameSpace);
+					++count;
+				}
+				++count;
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void SoapIterate(benchmark::State & state)
+	{
+		static std::string const xml = Documents::Soap(RecordCount);
+		Iterate(state, xml);
+	}
+
+	void XsdIterate(benchmark::State & state)
+	{
+		static std::string const xml = Documents::Xsd(RecordCount);
+		Iterate(state, xml);
+	}
+}
+
+BENCHMARK(LegacyNameSpaceLookup);
+BENCHMARK(FlatNameSpaceLookup);
+BENCHMARK(SoapIterate);
+BENCHMARK(XsdIterate);
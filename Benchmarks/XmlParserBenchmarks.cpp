@@ -0,0 +1,83 @@
+#include <GLib/Xml/Parser.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+// many small documents, reported as documents per second
+namespace
+{
+	constexpr size_t DocumentCount = 10000;
+
+	std::vector<std::string_view> const & Messages()
+	{
+		static std::vector<std::string> const messages = []
+		{
+			std::vector<std::string> values;
+			for (size_t i = 0; i < DocumentCount; ++i)
+			{
+				values.push_back(Documents::Soap(1 + i % 3));
+			}
+			return values;
+		}();
+		static std::vector<std::string_view> const views {messages.begin(), messages.end()};
+		return views;
+	}
+
+	size_t Count(GLib::Xml::Holder & holder)
+	{
+		size_t count {};
+		for (auto const & element : holder)
+		{
+			benchmark::DoNotOptimize(element);
+			++count;
+		}
+		return count;
+	}
+
+	// a holder, manager and state engine made for each document
+	void DocumentsHolder(benchmark::State & state)
+	{
+		auto const & messages = Messages();
+		for (auto _ : state)
+		{
+			for (auto const message : messages)
+			{
+				GLib::Xml::Holder holder {message};
+				benchmark::DoNotOptimize(Count(holder));
+			}
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+	}
+
+	void DocumentsParser(benchmark::State & state)
+	{
+		auto const & messages = Messages();
+		GLib::Xml::Parser parser;
+		for (auto _ : state)
+		{
+			for (auto const message : messages)
+			{
+				auto holder = parser.Parse(message);
+				benchmark::DoNotOptimize(Count(holder));
+			}
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+	}
+
+	// arg is the thread count
+	void DocumentsBatch(benchmark::State & state)
+	{
+		auto const & messages = Messages();
+		auto const threads = static_cast<size_t>(state.range(0));
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(GLib::Xml::ParseBatch(messages, Count, threads));
+		}
+		state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages.size()));
+	}
+}
+
+BENCHMARK(DocumentsHolder);
+BENCHMARK(DocumentsParser);
+BENCHMARK(DocumentsBatch)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
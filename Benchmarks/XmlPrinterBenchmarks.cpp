@@ -0,0 +1,81 @@
+#include "LegacyPrinter.h"
+
+#include <GLib/Xml/Printer.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+	constexpr size_t RecordCount = 1000;
+
+	// a report shaped document, nested records with attributes and escaped text
+	template <typename Printer>
+	void Print(Printer & printer)
+	{
+		printer.PushDeclaration();
+		printer.OpenElement("Report");
+		printer.PushAttribute("version", int64_t {3});
+		for (size_t i = 0; i < RecordCount; ++i)
+		{
+			printer.OpenElement("Record");
+			printer.PushAttribute("id", static_cast<int64_t>(i));
+			printer.PushAttribute("name", "Function<int> & co");
+			printer.OpenElement("Lines");
+			printer.PushAttribute("covered", int64_t {12});
+			printer.PushAttribute("total", int64_t {20});
+			printer.CloseElement();
+			printer.OpenElement("Note");
+			printer.PushText("if (a < b) return c;");
+			printer.CloseElement();
+			printer.CloseElement();
+		}
+		printer.Close();
+	}
+
+	std::string LegacyXml()
+	{
+		Legacy::Printer printer;
+		Print(printer);
+		return printer.Xml();
+	}
+
+	std::string BufferXml()
+	{
+		GLib::Xml::Printer printer;
+		Print(printer);
+		return printer.Release();
+	}
+
+	void PrinterLegacy(benchmark::State & state)
+	{
+		size_t bytes {};
+		for (auto _ : state)
+		{
+			auto const xml = LegacyXml();
+			bytes += xml.size();
+			benchmark::DoNotOptimize(xml);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	}
+
+	void PrinterBuffer(benchmark::State & state)
+	{
+		if (BufferXml() != LegacyXml())
+		{
+			state.SkipWithError("Output differs from the legacy printer");
+			return;
+		}
+
+		size_t bytes {};
+		for (auto _ : state)
+		{
+			auto const xml = BufferXml();
+			bytes += xml.size();
+			benchmark::DoNotOptimize(xml);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+	}
+}
+
+BENCHMARK(PrinterLegacy);
+BENCHMARK(PrinterBuffer);
@@ -0,0 +1,72 @@
+#include <GLib/Xml/Query.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+namespace
+{
+	constexpr size_t RecordCount = 20000;
+
+	std::string const & Xml()
+	{
+		static std::string const xml = Documents::Mixed(RecordCount);
+		return xml;
+	}
+
+	// every element and attribute visited, the work a hand written filter does for /feed/item/x:price/@currency
+	void QueryFullIteration(benchmark::State & state)
+	{
+		std::string_view const xml = Xml();
+		for (auto _ : state)
+		{
+			size_t count {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				if (element.Type() != GLib::Xml::ElementType::Open && element.Type() != GLib::Xml::ElementType::Empty)
+				{
+					continue;
+				}
+				for (auto const & attribute : element.GetAttributes())
+				{
+					count += element.Name() == "price" && element.NameSpace() == "urn:x" && attribute.Name == "currency" ? 1 : 0;
+				}
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void Run(benchmark::State & state, std::string_view const path)
+	{
+		std::string_view const xml = Xml();
+		GLib::Xml::Query const query {path, {{"x", "urn:x"}}};
+		for (auto _ : state)
+		{
+			size_t count {};
+			query.Run(xml, [&](GLib::Xml::Element const &, GLib::Xml::Attribute const *) { ++count; });
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void QueryChildPath(benchmark::State & state)
+	{
+		Run(state, "/feed/item/x:price/@currency");
+	}
+
+	void QueryDescendantPath(benchmark::State & state)
+	{
+		Run(state, "//item//x:price/@currency");
+	}
+
+	void QueryPredicate(benchmark::State & state)
+	{
+		Run(state, "/feed/item[@id='19999']/title");
+	}
+}
+
+BENCHMARK(QueryFullIteration);
+BENCHMARK(QueryChildPath);
+BENCHMARK(QueryDescendantPath);
+BENCHMARK(QueryPredicate);
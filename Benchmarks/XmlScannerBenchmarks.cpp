@@ -0,0 +1,100 @@
+#include <GLib/Xml/Iterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+namespace
+{
+	constexpr size_t RecordCount = 1000;
+
+	std::string const & Document()
+	{
+		static std::string const xml = Documents::TextHeavy(RecordCount);
+		return xml;
+	}
+
+	template <typename Function>
+	void Scan(benchmark::State & state, Function function)
+	{
+		std::string_view const xml = Document();
+		char const * const end = xml.data() + xml.size();
+		for (auto _ : state)
+		{
+			size_t stops {};
+			for (char const * ptr = xml.data(); ptr != end; ++ptr)
+			{
+				ptr = function(ptr, end).end;
+				if (ptr == end)
+				{
+					break;
+				}
+				++stops;
+			}
+			benchmark::DoNotOptimize(stops);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void ScannerScalar(benchmark::State & state)
+	{
+		Scan(state, [](char const * ptr, char const * end) { return GLib::Xml::Scanner::SkipScalar(ptr, end, GLib::Xml::Scanner::Delimiters<2> {'<', '&'}); });
+	}
+
+	void ScannerSimd(benchmark::State & state)
+	{
+		Scan(state, [](char const * ptr, char const * end) { return GLib::Xml::Scanner::Skip(ptr, end, GLib::Xml::Scanner::Delimiters<2> {'<', '&'}); });
+	}
+
+	void TextHeavyIterate(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			size_t count {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				benchmark::DoNotOptimize(element);
+				++count;
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void Decode(benchmark::State & state, std::string const & value)
+	{
+		std::string buffer;
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(GLib::Xml::Utils::Decode(value, buffer));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+	}
+
+	void DecodeClean(benchmark::State & state)
+	{
+		static std::string const value = Document().substr(0, 4096);
+		Decode(state, value);
+	}
+
+	void DecodeEntities(benchmark::State & state)
+	{
+		static std::string const value = []
+		{
+			std::string result;
+			while (result.size() < 4096)
+			{
+				result += "price &lt; 10 &amp;&amp; name = &quot;caf&#xE9;&quot; ";
+			}
+			return result;
+		}();
+		Decode(state, value);
+	}
+}
+
+BENCHMARK(ScannerScalar);
+BENCHMARK(ScannerSimd);
+BENCHMARK(TextHeavyIterate);
+BENCHMARK(DecodeClean);
+BENCHMARK(DecodeEntities);
@@ -0,0 +1,239 @@
+#include <GLib/Xml/AttributeIterator.h>
+#include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Printer.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Allocations.h"
+#include "Documents.h"
+
+#include <array>
+#include <memory_resource>
+
+// the hot paths over documents of different shapes, reported as bytes per second and heap allocations per element
+namespace
+{
+	enum Shape : int64_t
+	{
+		Deep,
+		Wide,
+		AttributeHeavy,
+		TextHeavy,
+		NameSpaceHeavy,
+
+		ShapeCount
+	};
+
+	std::string const & Document(int64_t const shape)
+	{
+		static std::array<std::string, ShapeCount> const documents {
+			Documents::Deep(200, 150), Documents::Wide(50000), Documents::AttributeHeavy(5000), Documents::TextHeavy(200), Documents::Soap(5000)};
+		return documents.at(static_cast<size_t>(shape));
+	}
+
+	// function(xml) returns the number of elements it processed
+	template <typename Function>
+	void Measure(benchmark::State & state, Function const & function)
+	{
+		std::string_view const xml = Document(state.range(0));
+		size_t elements {};
+		uint64_t const allocations = Allocations::Count();
+		for (auto _ : state)
+		{
+			elements += function(xml);
+		}
+		auto const allocated = static_cast<double>(Allocations::Count() - allocations);
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+		state.SetItemsProcessed(static_cast<int64_t>(elements));
+		state.counters["allocs/element"] = elements == 0 ? 0 : allocated / static_cast<double>(elements);
+	}
+
+	void ShapeIterate(benchmark::State & state)
+	{
+		Measure(state,
+						[](std::string_view const xml)
+						{
+							size_t count {};
+							for (auto const & element : GLib::Xml::Holder {xml})
+							{
+								benchmark::DoNotOptimize(element);
+								++count;
+							}
+							return count;
+						});
+	}
+
+	void ShapeAttributes(benchmark::State & state)
+	{
+		Measure(state,
+						[](std::string_view const xml)
+						{
+							size_t count {};
+							std::string buffer;
+							for (auto const & element : GLib::Xml::Holder {xml})
+							{
+								for (auto const & attribute : element.GetAttributes())
+								{
+									benchmark::DoNotOptimize(attribute.DecodedValue(buffer));
+								}
+								++count;
+							}
+							return count;
+						});
+	}
+
+	// element and attribute names resolved to their namespaces
+	void ShapeNameSpaces(benchmark::State & state)
+	{
+		Measure(state,
+						[](std::string_view const xml)
+						{
+							size_t count {};
+							size_t resolved {};
+							for (auto const & element : GLib::Xml::Holder {xml})
+							{
+								resolved += element.NameSpace().size();
+								for (auto const & attribute : element.GetAttributes())
+								{
+									resolved += attribute.NameSpace.size();
+								}
+								++count;
+							}
+							benchmark::DoNotOptimize(resolved);
+							return count;
+						});
+	}
+
+	size_t Print(std::string_view const xml, GLib::Xml::Printer & printer)
+	{
+		size_t count {};
+		std::string buffer;
+		for (auto const & element : GLib::Xml::Holder {xml})
+		{
+			switch (element.Type())
+			{
+				case GLib::Xml::ElementType::Open:
+				case GLib::Xml::ElementType::Empty:
+				{
+					printer.OpenElement(element.QName());
+					for (auto const & attribute : element.IndexedAttributes())
+					{
+						printer.PushAttribute(attribute.QName, attribute.DecodedValue(buffer));
+					}
+					if (element.Type() == GLib::Xml::ElementType::Empty)
+					{
+						printer.CloseElement();
+					}
+					break;
+				}
+
+				case GLib::Xml::ElementType::Close:
+				{
+					printer.CloseElement();
+					break;
+				}
+
+				case GLib::Xml::ElementType::Text:
+				{
+					printer.PushText(element.DecodedText(buffer));
+					break;
+				}
+
+				default:
+				{
+					continue; // comments are not printed
+				}
+			}
+			++count;
+		}
+		return count;
+	}
+
+	// parse and print again, the output is checked to print the same number of elements
+	void ShapeRoundTrip(benchmark::State & state)
+	{
+		{
+			GLib::Xml::Printer printer {false};
+			size_t const original = Print(Document(state.range(0)), printer);
+			std::string const output = printer.Release();
+			GLib::Xml::Printer again {false};
+			if (Print(output, again) != original || again.Release() != output)
+			{
+				state.SkipWithError("Round trip changed the document");
+				return;
+			}
+		}
+
+		GLib::Xml::Printer printer {false};
+		Measure(state,
+						[&](std::string_view const xml)
+						{
+							size_t const count = Print(xml, printer);
+							benchmark::DoNotOptimize(printer.Release());
+							return count;
+						});
+	}
+
+	// many small documents, as a worker handling messages would parse them, heap allocations are counted per message
+	template <typename Parse>
+	void SmallMessages(benchmark::State & state, Parse const & parse)
+	{
+		static std::string const message = Documents::Soap(2);
+		uint64_t const allocations = Allocations::Count();
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(parse(message));
+		}
+		auto const allocated = static_cast<double>(Allocations::Count() - allocations);
+
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * message.size()));
+		state.counters["allocs/message"] = allocated / static_cast<double>(state.iterations());
+	}
+
+	size_t Count(GLib::Xml::Holder & holder)
+	{
+		size_t count {};
+		for (auto const & element : holder)
+		{
+			count += element.GetAttributes().Empty() ? 1 : 2;
+		}
+		return count;
+	}
+
+	void SmallMessagesHeap(benchmark::State & state)
+	{
+		SmallMessages(state,
+									[](std::string_view const xml)
+									{
+										GLib::Xml::Holder holder {xml};
+										return Count(holder);
+									});
+	}
+
+	// the working data from an arena released after each message
+	void SmallMessagesArena(benchmark::State & state)
+	{
+		std::array<std::byte, 16 * 1024> buffer {};
+		std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+		SmallMessages(state,
+									[&](std::string_view const xml)
+									{
+										size_t count {};
+										{
+											GLib::Xml::Holder holder {xml, &arena};
+											count = Count(holder);
+										}
+										arena.release();
+										return count;
+									});
+	}
+}
+
+// 0 deep, 1 wide, 2 attribute heavy, 3 text heavy, 4 namespace heavy
+BENCHMARK(ShapeIterate)->DenseRange(0, ShapeCount - 1);
+BENCHMARK(ShapeAttributes)->DenseRange(0, ShapeCount - 1);
+BENCHMARK(ShapeNameSpaces)->DenseRange(0, ShapeCount - 1);
+BENCHMARK(ShapeRoundTrip)->DenseRange(0, ShapeCount - 1);
+BENCHMARK(SmallMessagesHeap);
+BENCHMARK(SmallMessagesArena);
@@ -0,0 +1,133 @@
+#include <GLib/Xml/Iterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+#include "LegacyStateEngine.h"
+
+namespace
+{
+	constexpr size_t RecordCount = 10000;
+
+	std::string const & Document()
+	{
+		static std::string const xml = Documents::Mixed(RecordCount);
+		return xml;
+	}
+
+	template <typename Engine>
+	size_t PushAll(std::string_view const xml)
+	{
+		Engine engine;
+		size_t transitions {};
+		auto state = engine.GetState();
+		for (char const chr : xml)
+		{
+			auto const newState = engine.Push(chr);
+			transitions += newState != state ? 1 : 0;
+			state = newState;
+		}
+		return transitions;
+	}
+
+	bool SameStates(std::string_view const xml)
+	{
+		GLib::Xml::StateEngine engine;
+		Legacy::StateEngine legacy;
+		for (char const chr : xml)
+		{
+			if (engine.Push(chr) != legacy.Push(chr))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename Engine>
+	void StateEnginePush(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		if (!SameStates(xml))
+		{
+			state.SkipWithError("State sequence differs from legacy engine");
+			return;
+		}
+
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(PushAll<Engine>(xml));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void LegacyStateEngine(benchmark::State & state)
+	{
+		StateEnginePush<Legacy::StateEngine>(state);
+	}
+
+	void TableStateEngine(benchmark::State & state)
+	{
+		StateEnginePush<GLib::Xml::StateEngine>(state);
+	}
+
+	void HolderIterate(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			size_t count {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				benchmark::DoNotOptimize(element);
+				++count;
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	// positions asked for every element, the newline count moves forward with the requests
+	void HolderIteratePositions(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			size_t lines {};
+			GLib::Xml::Holder holder {xml};
+			for (auto it = holder.begin(), end = holder.end(); it != end; ++it)
+			{
+				lines += it.GetPosition().Line;
+			}
+			benchmark::DoNotOptimize(lines);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	// only the root's children are produced, each record is skipped
+	void HolderSkipSubtrees(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			size_t count {};
+			GLib::Xml::Holder holder {xml};
+			for (auto it = holder.begin(), end = holder.end(); it != end; ++it)
+			{
+				if (it->Type() == GLib::Xml::ElementType::Open && it->Depth() == 2)
+				{
+					it.SkipSubtree();
+				}
+				++count;
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+}
+
+BENCHMARK(LegacyStateEngine);
+BENCHMARK(TableStateEngine);
+BENCHMARK(HolderIterate);
+BENCHMARK(HolderIteratePositions);
+BENCHMARK(HolderSkipSubtrees);
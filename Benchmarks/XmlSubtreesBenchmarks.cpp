@@ -0,0 +1,76 @@
+#include <GLib/Xml/Subtrees.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+#include <atomic>
+
+namespace
+{
+	constexpr size_t RecordCount = 20000;
+
+	std::string const & Document()
+	{
+		static std::string const xml = Documents::Mixed(RecordCount);
+		return xml;
+	}
+
+	void SubtreesSequential(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			size_t count {};
+			for (auto const & element : GLib::Xml::Holder {xml})
+			{
+				benchmark::DoNotOptimize(element);
+				++count;
+			}
+			benchmark::DoNotOptimize(count);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void SubtreesPreScan(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		for (auto _ : state)
+		{
+			GLib::Xml::Subtrees const subtrees {xml};
+			benchmark::DoNotOptimize(subtrees.Children().size());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	// pre-scan plus parallel parse, arg is the thread count
+	void SubtreesParallel(benchmark::State & state)
+	{
+		std::string_view const xml = Document();
+		auto const threads = static_cast<size_t>(state.range(0));
+		for (auto _ : state)
+		{
+			std::atomic<size_t> total {};
+			GLib::Xml::Subtrees const subtrees {xml};
+			GLib::Xml::ForEachSubtree(
+				subtrees,
+				[&](size_t /*index*/, GLib::Xml::Holder & holder)
+				{
+					size_t count {};
+					for (auto const & element : holder)
+					{
+						benchmark::DoNotOptimize(element);
+						++count;
+					}
+					total += count;
+				},
+				threads);
+			benchmark::DoNotOptimize(total.load());
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+}
+
+BENCHMARK(SubtreesSequential)->UseRealTime();
+BENCHMARK(SubtreesPreScan)->UseRealTime();
+BENCHMARK(SubtreesParallel)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
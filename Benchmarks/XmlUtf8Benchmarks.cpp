@@ -0,0 +1,90 @@
+#include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Utf8.h>
+
+#include <benchmark/benchmark.h>
+
+#include "Documents.h"
+
+namespace
+{
+	constexpr size_t RecordCount = 1000;
+
+	std::string const & Document(int const kind)
+	{
+		static std::string const mixed = Documents::Mixed(RecordCount);
+		static std::string const textHeavy = Documents::TextHeavy(RecordCount);
+		static std::string const international = Documents::International(RecordCount);
+		switch (kind)
+		{
+			case 0:
+				return mixed;
+			case 1:
+				return textHeavy;
+			default:
+				return international;
+		}
+	}
+
+	size_t Iterate(std::string_view const xml, GLib::Xml::Utf8::Validation const validation)
+	{
+		size_t count {};
+		for (auto const & element : GLib::Xml::Holder {xml, validation})
+		{
+			benchmark::DoNotOptimize(element);
+			++count;
+		}
+		return count;
+	}
+
+	void Utf8Unchecked(benchmark::State & state)
+	{
+		std::string_view const xml = Document(static_cast<int>(state.range(0)));
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Iterate(xml, GLib::Xml::Utf8::Validation::Off));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	// validation in the parse loop
+	void Utf8Fused(benchmark::State & state)
+	{
+		std::string_view const xml = Document(static_cast<int>(state.range(0)));
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(Iterate(xml, GLib::Xml::Utf8::Validation::On));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	// the previous approach, a validation pass then the parse
+	void Utf8SeparatePass(benchmark::State & state)
+	{
+		std::string_view const xml = Document(static_cast<int>(state.range(0)));
+		for (auto _ : state)
+		{
+			if (!GLib::Xml::Utf8::IsValid(xml))
+			{
+				state.SkipWithError("invalid");
+			}
+			benchmark::DoNotOptimize(Iterate(xml, GLib::Xml::Utf8::Validation::Off));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+
+	void Utf8Validate(benchmark::State & state)
+	{
+		std::string_view const xml = Document(static_cast<int>(state.range(0)));
+		for (auto _ : state)
+		{
+			benchmark::DoNotOptimize(GLib::Xml::Utf8::IsValid(xml));
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * xml.size()));
+	}
+}
+
+// 0 mixed, 1 text heavy, 2 international
+BENCHMARK(Utf8Unchecked)->DenseRange(0, 2);
+BENCHMARK(Utf8Fused)->DenseRange(0, 2);
+BENCHMARK(Utf8SeparatePass)->DenseRange(0, 2);
+BENCHMARK(Utf8Validate)->DenseRange(0, 2);
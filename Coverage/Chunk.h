@@ -13,18 +13,7 @@ struct Chunk
 template <>
 struct GLib::Eval::Visitor<Chunk>
 {
-	static void Visit(Chunk const & chunk, std::string const & propertyName, ValueVisitor const & visitor)
-	{
-		if (propertyName == "cover")
-		{
-			return visitor(Value(chunk.Cover));
-		}
-
-		if (propertyName == "size")
-		{
-			return visitor(Value(chunk.Size));
-		}
-
-		throw std::runtime_error("Unknown property : '" + propertyName + '\'');
-	}
+	static constexpr std::array Properties {
+		Property<Chunk> {"cover", [](Chunk const & chunk, ValueVisitor const & visitor) { visitor(Value(chunk.Cover)); }},
+		Property<Chunk> {"size", [](Chunk const & chunk, ValueVisitor const & visitor) { visitor(Value(chunk.Size)); }}};
 };
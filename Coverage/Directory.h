@@ -88,63 +88,16 @@ public:
 template <>
 struct GLib::Eval::Visitor<Directory>
 {
-	static void Visit(Directory const & dir, std::string const & propertyName, ValueVisitor const & visitor)
-	{
-		if (propertyName == "name")
-		{
-			return visitor(Value(dir.Name()));
-		}
-
-		if (propertyName == "link")
-		{
-			return visitor(Value(dir.Link()));
-		}
-
-		if (propertyName == "coveragePercent")
-		{
-			return visitor(Value(dir.CoveragePercent()));
-		}
-
-		if (propertyName == "coveredLines")
-		{
-			return visitor(Value(dir.CoveredLines()));
-		}
-
-		if (propertyName == "coverableLines")
-		{
-			return visitor(Value(dir.CoverableLines()));
-		}
-
-		if (propertyName == "coverageStyle")
-		{
-			return visitor(Value(dir.Style()));
-		}
-
-		if (propertyName == "minCoveragePercent")
-		{
-			return visitor(Value(dir.MinCoveragePercent()));
-		}
-
-		if (propertyName == "minCoverageStyle")
-		{
-			return visitor(Value(dir.MinCoverageStyle()));
-		}
-
-		if (propertyName == "coveredFunctions")
-		{
-			return visitor(Value(dir.CoveredFunctions()));
-		}
-
-		if (propertyName == "coverableFunctions")
-		{
-			return visitor(Value(dir.CoverableFunctions()));
-		}
-
-		if (propertyName == "coveredFunctionsPercent")
-		{
-			return visitor(Value(dir.CoveredFunctionsPercent()));
-		}
-
-		throw std::runtime_error("Unknown property : '" + propertyName + '\'');
-	}
+	static constexpr std::array Properties {
+		Property<Directory> {"name", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.Name())); }},
+		Property<Directory> {"link", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.Link())); }},
+		Property<Directory> {"coveragePercent", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoveragePercent())); }},
+		Property<Directory> {"coveredLines", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoveredLines())); }},
+		Property<Directory> {"coverableLines", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoverableLines())); }},
+		Property<Directory> {"coverageStyle", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.Style())); }},
+		Property<Directory> {"minCoveragePercent", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.MinCoveragePercent())); }},
+		Property<Directory> {"minCoverageStyle", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.MinCoverageStyle())); }},
+		Property<Directory> {"coveredFunctions", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoveredFunctions())); }},
+		Property<Directory> {"coverableFunctions", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoverableFunctions())); }},
+		Property<Directory> {"coveredFunctionsPercent", [](Directory const & dir, ValueVisitor const & visitor) { visitor(Value(dir.CoveredFunctionsPercent())); }}};
 };
@@ -9,40 +9,27 @@
 template <>
 struct GLib::Eval::Visitor<FunctionCoverage>
 {
-	static void Visit(FunctionCoverage const & coverage, std::string const & propertyName, ValueVisitor const & visitor)
-	{
-		if (propertyName == "name")
-		{
-			std::ostringstream stm;
-			if (!coverage.NameSpace().empty())
-			{
-				Xml::Utils::Escape(coverage.NameSpace(), stm) << "::";
-			}
-			if (!coverage.ClassName().empty())
-			{
-				Xml::Utils::Escape(coverage.ClassName(), stm) << "::";
-			}
-			Xml::Utils::Escape(coverage.FunctionName(), stm);
-			return visitor(Value(stm.str()));
-		}
-		if (propertyName == "line")
-		{
-			return visitor(Value(coverage.Line()));
-		}
-		if (propertyName == "coveredLines")
-		{
-			return visitor(Value(coverage.CoveredLines()));
-		}
-		if (propertyName == "coverableLines")
-		{
-			return visitor(Value(coverage.CoverableLines()));
-		}
-
-		if (propertyName == "cover")
-		{
-			return visitor(Value(coverage.CoveredLines() != 0 ? LineCover::Covered : LineCover::NotCovered));
-		}
-
-		throw std::runtime_error("Unknown property : '" + propertyName + '\'');
-	}
+	static constexpr std::array Properties {
+		Property<FunctionCoverage> {"name",
+																[](FunctionCoverage const & coverage, ValueVisitor const & visitor)
+																{
+																	std::ostringstream stm;
+																	if (!coverage.NameSpace().empty())
+																	{
+																		Xml::Utils::Escape(coverage.NameSpace(), stm) << "::";
+																	}
+																	if (!coverage.ClassName().empty())
+																	{
+																		Xml::Utils::Escape(coverage.ClassName(), stm) << "::";
+																	}
+																	Xml::Utils::Escape(coverage.FunctionName(), stm);
+																	visitor(Value(stm.str()));
+																}},
+		Property<FunctionCoverage> {"line", [](FunctionCoverage const & coverage, ValueVisitor const & visitor) { visitor(Value(coverage.Line())); }},
+		Property<FunctionCoverage> {"coveredLines",
+																[](FunctionCoverage const & coverage, ValueVisitor const & visitor) { visitor(Value(coverage.CoveredLines())); }},
+		Property<FunctionCoverage> {"coverableLines",
+																[](FunctionCoverage const & coverage, ValueVisitor const & visitor) { visitor(Value(coverage.CoverableLines())); }},
+		Property<FunctionCoverage> {"cover", [](FunctionCoverage const & coverage, ValueVisitor const & visitor)
+																{ visitor(Value(coverage.CoveredLines() != 0 ? LineCover::Covered : LineCover::NotCovered)); }}};
 };
@@ -24,6 +24,23 @@
 
 using GLib::Cvt::P2A;
 
+namespace
+{
+	// what a source file's pages refer to, owned by its render job
+	struct SourceFileState
+	{
+		std::vector<Line> lines;
+		std::vector<Chunk> chunks;
+		std::multiset<FunctionCoverage> coverage;
+	};
+
+	// a missing source file is skipped with a warning, any other failure aborts the report
+	struct SourceFileUnreadable : std::runtime_error
+	{
+		using std::runtime_error::runtime_error;
+	};
+}
+
 std::string LoadHtml(unsigned int const idValue)
 {
 	return GLib::Win::LoadResourceString(nullptr, idValue, RT_HTML); // NOLINT bad macro
@@ -63,6 +80,7 @@ HtmlReport::HtmlReport(std::string testName, std::filesystem::path const & htmlP
 	}
 	bool const multipleDrives = drives.size() > 1;
 
+	std::vector<GLib::Html::RenderJob> jobs;
 	for (FileCoverageData const & data : coverageData | std::views::values)
 	{
 		auto [rootPath, subPath] = Reduce(data.Path(), rootPaths);
@@ -72,9 +90,10 @@ HtmlReport::HtmlReport(std::string testName, std::filesystem::path const & htmlP
 			auto const drive = P2A(rootPath.root_name()).substr(0, 1);
 			subPath = std::filesystem::path {drive} / subPath;
 		}
-		GenerateSourceFile(subPath, data);
+		jobs.push_back(SourceFileJob(subPath, data));
 		index[subPath.parent_path()].push_back(data);
 	}
+	RenderSourceFiles(std::move(jobs));
 
 	GenerateRootIndex();
 	GenerateIndices();
@@ -253,156 +272,175 @@ void HtmlReport::GenerateIndices() const
 	}
 }
 
-void HtmlReport::GenerateSourceFile(std::filesystem::path const & subPath, FileCoverageData const & data) const
+void HtmlReport::RenderSourceFiles(std::vector<GLib::Html::RenderJob> jobs) const
 {
-	auto const & targetPath = htmlPath / subPath;
-	auto const & relativePath = relative(htmlPath, targetPath.parent_path());
+	std::vector<std::filesystem::path> paths;
+	paths.reserve(jobs.size());
+	for (auto const & job : jobs)
+	{
+		paths.push_back(job.Pages.front().Path);
+	}
 
-	std::filesystem::path const & sourceFile = data.Path();
-	std::ifstream const stm(sourceFile);
-	if (!stm)
+	// the jobs are moved in so each file's lines and chunks are released once its pages are rendered
+	auto const timings = GLib::Html::RenderBatch(std::move(jobs));
+	for (size_t job = 0; job < timings.size(); ++job)
 	{
-		log.Warning("Unable to open input file : {0}", P2A(sourceFile));
-		// generate error file
-		return;
+		auto const & timing = timings[job];
+		auto const & path = paths[job];
+		if (!timing.Ok())
+		{
+			try
+			{
+				std::rethrow_exception(timing.Exception);
+			}
+			catch (SourceFileUnreadable const &)
+			{
+				continue;
+			}
+		}
+
+		auto const ms = [](std::chrono::nanoseconds const value) { return std::chrono::duration_cast<std::chrono::milliseconds>(value).count(); };
+		log.Debug("Generated '{0}' : {1} bytes, prepare {2} ms, render {3} ms, write {4} ms", P2A(path), timing.Bytes, ms(timing.Prepare),
+							ms(timing.Render), ms(timing.Write));
 	}
+}
 
-	auto const & lineCoverage = data.LineCoverage();
+GLib::Html::RenderJob HtmlReport::SourceFileJob(std::filesystem::path const & subPath, FileCoverageData const & data) const
+{
+	std::filesystem::path filePage = htmlPath / subPath;
+	filePage += L".html";
+	std::filesystem::path functionsPage = htmlPath / subPath;
+	functionsPage += L".functions.html";
 
-	std::string source;
+	// runs on a render thread
+	auto prepare = [this, subPath, &data, state = std::make_shared<SourceFileState>()](GLib::Eval::Evaluator & eval)
 	{
-		std::stringstream buffer;
-		buffer << stm.rdbuf();
+		auto const & targetPath = htmlPath / subPath;
+		auto const & relativePath = relative(htmlPath, targetPath.parent_path());
 
-		try
+		std::filesystem::path const & sourceFile = data.Path();
+		std::ifstream const stm(sourceFile);
+		if (!stm)
 		{
-			std::stringstream tmp;
-			Htmlify(buffer.str(), showWhiteSpace, tmp);
-			source = tmp.str();
+			log.Warning("Unable to open input file : {0}", P2A(sourceFile));
+			// generate error file
+			throw SourceFileUnreadable("Unable to open input file : " + P2A(sourceFile));
 		}
-		catch (std::exception const & e)
+
+		auto const & lineCoverage = data.LineCoverage();
+
+		std::string source;
 		{
-			log.Warning("Failed to parse source file '{0}' : {1}", P2A(sourceFile), e.what());
-			source = buffer.str();
+			std::stringstream buffer;
+			buffer << stm.rdbuf();
+
+			try
+			{
+				std::stringstream tmp;
+				Htmlify(buffer.str(), showWhiteSpace, tmp);
+				source = tmp.str();
+			}
+			catch (std::exception const & e)
+			{
+				log.Warning("Failed to parse source file '{0}' : {1}", P2A(sourceFile), e.what());
+				source = buffer.str();
+			}
 		}
-	}
 
-	std::vector<Line> lines;
+		std::vector<Line> & lines = state->lines;
 
-	for (auto const & sourceLine : GLib::Util::Splitter {source, "\n"})
-	{
-		auto const lineNumber = static_cast<unsigned int>(lines.size() + 1);
-		LineCover cover {};
-		auto const iter = lineCoverage.find(lineNumber);
-		if (iter != lineCoverage.end())
+		for (auto const & sourceLine : GLib::Util::Splitter {source, "\n"})
 		{
-			cover = iter->second == 0 ? LineCover::NotCovered : LineCover::Covered;
+			auto const lineNumber = static_cast<unsigned int>(lines.size() + 1);
+			LineCover cover {};
+			auto const iter = lineCoverage.find(lineNumber);
+			if (iter != lineCoverage.end())
+			{
+				cover = iter->second == 0 ? LineCover::NotCovered : LineCover::Covered;
+			}
+			lines.push_back({sourceLine, {}, {}, cover, {}});
 		}
-		lines.push_back({sourceLine, {}, {}, cover, {}});
-	}
 
-	auto const maxLineNumberWidth = static_cast<unsigned int>(floor(log10(lines.size()))) + 1;
-	for (size_t i = 0; i < lines.size(); ++i)
-	{
-		std::ostringstream paddedLineNumber;
-		paddedLineNumber << std::setw(maxLineNumberWidth) << i + 1; // use a width format specifier in template?
-		lines[i].PaddedNumber = paddedLineNumber.str();
-		lines[i].Number = static_cast<unsigned int>(i + 1);
-	}
+		auto const maxLineNumberWidth = static_cast<unsigned int>(floor(log10(lines.size()))) + 1;
+		for (size_t i = 0; i < lines.size(); ++i)
+		{
+			std::ostringstream paddedLineNumber;
+			paddedLineNumber << std::setw(maxLineNumberWidth) << i + 1; // use a width format specifier in template?
+			lines[i].PaddedNumber = paddedLineNumber.str();
+			lines[i].Number = static_cast<unsigned int>(i + 1);
+		}
 
-	constexpr int effectiveHeaderLines = 10;
-	constexpr int effectiveFooterLines = 3;
-	auto const effectiveLines = lines.size() + effectiveHeaderLines + effectiveFooterLines;
-	auto const ratio = HundredPercent / static_cast<float>(effectiveLines);
+		constexpr int effectiveHeaderLines = 10;
+		constexpr int effectiveFooterLines = 3;
+		auto const effectiveLines = lines.size() + effectiveHeaderLines + effectiveFooterLines;
+		auto const ratio = HundredPercent / static_cast<float>(effectiveLines);
 
-	auto const pred = [](Line const & line1, Line const & line2) { return line1.Cover != line2.Cover; };
+		auto const pred = [](Line const & line1, Line const & line2) { return line1.Cover != line2.Cover; };
 
-	std::vector<Chunk> chunks;
-	chunks.push_back({LineCover::None, effectiveHeaderLines * ratio});
-	for (auto it = lines.begin(), end = lines.end(), next = end; it != end; it = next)
-	{
-		next = GLib::Util::ConsecutiveFind(it, end, pred);
-		auto const size = static_cast<float>(std::distance(it, next));
-		chunks.push_back({it->Cover, size * ratio});
-	}
-	chunks.push_back({LineCover::None, effectiveFooterLines * ratio});
-
-	GLib::Eval::Evaluator eval;
+		std::vector<Chunk> & chunks = state->chunks;
+		chunks.push_back({LineCover::None, effectiveHeaderLines * ratio});
+		for (auto it = lines.begin(), end = lines.end(), next = end; it != end; it = next)
+		{
+			next = GLib::Util::ConsecutiveFind(it, end, pred);
+			auto const size = static_cast<float>(std::distance(it, next));
+			chunks.push_back({it->Cover, size * ratio});
+		}
+		chunks.push_back({LineCover::None, effectiveFooterLines * ratio});
 
-	auto const parent = subPath.parent_path();
-	auto const css = P2A(relativePath / "coverage.css");
-	auto const coveragePercent = Percentage(data.CoveredLines(), lineCoverage.size());
-	auto const coverageFunctionPercent = Percentage(data.CoveredFunctions(), data.CoverableFunctions());
+		auto const parent = subPath.parent_path();
+		auto const css = P2A(relativePath / "coverage.css");
+		auto const coveragePercent = Percentage(data.CoveredLines(), lineCoverage.size());
+		auto const coverageFunctionPercent = Percentage(data.CoveredFunctions(), data.CoverableFunctions());
 
-	eval.Set("title", P2A(subPath));
-	eval.Set("testName", testName);
-	eval.Set("time", time);
-	eval.Set("parent", P2A(parent));
-	eval.Set("fileName", P2A(targetPath.filename()));
-	eval.Set("styleSheet", css);
-	eval.Set("coverageStyle", GetCoverageLevel(coveragePercent));
+		eval.Set("title", P2A(subPath));
+		eval.Set("testName", testName);
+		eval.Set("time", time);
+		eval.Set("parent", P2A(parent));
+		eval.Set("fileName", P2A(targetPath.filename()));
+		eval.Set("styleSheet", css);
+		eval.Set("coverageStyle", GetCoverageLevel(coveragePercent));
 
-	eval.Set("coveredLines", data.CoveredLines());
-	eval.Set("coverableLines", lineCoverage.size());
-	eval.Set("coveragePercent", coveragePercent);
+		eval.Set("coveredLines", data.CoveredLines());
+		eval.Set("coverableLines", lineCoverage.size());
+		eval.Set("coveragePercent", coveragePercent);
 
-	eval.Set("coveredFunctions", data.CoveredFunctions());
-	eval.Set("coverableFunctions", data.CoverableFunctions());
-	eval.Set("coverageFunctionsPercent", coverageFunctionPercent);
-	eval.Set("coverageFunctionsStyle", GetCoverageLevel(coverageFunctionPercent));
+		eval.Set("coveredFunctions", data.CoveredFunctions());
+		eval.Set("coverableFunctions", data.CoverableFunctions());
+		eval.Set("coverageFunctionsPercent", coverageFunctionPercent);
+		eval.Set("coverageFunctionsStyle", GetCoverageLevel(coverageFunctionPercent));
 
-	eval.Set("index", P2A(relativePath / "index.html"));
+		eval.Set("index", P2A(relativePath / "index.html"));
 
-	eval.SetCollection("lines", lines);
-	eval.SetCollection("chunks", chunks);
+		eval.SetCollection("lines", lines);
+		eval.SetCollection("chunks", chunks);
 
-	std::multiset<FunctionCoverage> coverage;
-	for (auto const & function : data.Functions())
-	{
-		for (auto const & [file, l] : function.FileLines())
+		std::multiset<FunctionCoverage> & coverage = state->coverage;
+		for (auto const & function : data.Functions())
 		{
-			if (file == sourceFile)
+			for (auto const & [file, l] : function.FileLines())
 			{
-				unsigned int const oneBasedLine = l.begin()->first;
+				if (file == sourceFile)
+				{
+					unsigned int const oneBasedLine = l.begin()->first;
 
-				// 0 can causes out of range for debug global delete, todo remove this and replace with jscript offset on navigate
-				constexpr unsigned int functionOffset = 1;
+					// 0 can causes out of range for debug global delete, todo remove this and replace with jscript offset on navigate
+					constexpr unsigned int functionOffset = 1;
 
-				unsigned int zeroBasedLine {};
-				if (oneBasedLine >= functionOffset)
-				{
-					zeroBasedLine = oneBasedLine - 1 - functionOffset;
-				}
+					unsigned int zeroBasedLine {};
+					if (oneBasedLine >= functionOffset)
+					{
+						zeroBasedLine = oneBasedLine - 1 - functionOffset;
+					}
 
-				lines[zeroBasedLine].HasLink = true;
-				coverage.emplace(function.NameSpace(), function.ClassName(), function.FunctionName(), zeroBasedLine + 1,
-												 static_cast<unsigned int>(function.CoveredLines()), static_cast<unsigned int>(function.AllLines()));
+					lines[zeroBasedLine].HasLink = true;
+					coverage.emplace(function.NameSpace(), function.ClassName(), function.FunctionName(), zeroBasedLine + 1,
+													 static_cast<unsigned int>(function.CoveredLines()), static_cast<unsigned int>(function.AllLines()));
+				}
 			}
 		}
-	}
 
-	eval.SetCollection("functions", coverage);
+		eval.SetCollection("functions", coverage);
+	};
 
-	create_directories(targetPath.parent_path());
-	{
-		std::filesystem::path tmp = targetPath;
-		tmp += L".html";
-		std::ofstream out(tmp);
-		if (!out)
-		{
-			throw std::runtime_error("Unable to create file");
-		}
-		GLib::Html::Generate(eval, fileTemplate, out);
-	}
-
-	{
-		std::filesystem::path tmp = targetPath;
-		tmp += L".functions.html";
-		std::ofstream out(tmp);
-		if (!out)
-		{
-			throw std::runtime_error("Unable to create file");
-		}
-		GLib::Html::Generate(eval, functionsTemplate, out);
-	}
-}
\ No newline at end of file
+	return {std::move(prepare), {{&fileTemplate, std::move(filePage)}, {&functionsTemplate, std::move(functionsPage)}}};
+}
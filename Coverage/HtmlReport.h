@@ -3,6 +3,7 @@
 #include "Types.h"
 
 #include <GLib/Flogging.h>
+#include <GLib/Html/RenderBatch.h>
 
 #include <list>
 
@@ -17,10 +18,10 @@ class HtmlReport
 	std::filesystem::path const & htmlPath;
 	std::set<std::filesystem::path> const rootPaths;
 	std::filesystem::path const cssPath;
-	std::string const rootTemplate;
-	std::string const dirTemplate;
-	std::string const fileTemplate;
-	std::string const functionsTemplate;
+	GLib::Html::CompiledTemplate const rootTemplate;
+	GLib::Html::CompiledTemplate const dirTemplate;
+	GLib::Html::CompiledTemplate const fileTemplate;
+	GLib::Html::CompiledTemplate const functionsTemplate;
 	std::map<std::filesystem::path, std::list<FileCoverageData>> index;
 	bool const showWhiteSpace;
 
@@ -30,7 +31,8 @@ public:
 private:
 	void GenerateRootIndex() const;
 	void GenerateIndices() const;
-	void GenerateSourceFile(std::filesystem::path const & subPath, FileCoverageData const & data) const;
+	[[nodiscard]] GLib::Html::RenderJob SourceFileJob(std::filesystem::path const & subPath, FileCoverageData const & data) const;
+	void RenderSourceFiles(std::vector<GLib::Html::RenderJob> jobs) const;
 
 	static std::filesystem::path Initialise(std::filesystem::path const & path);
 	static std::set<std::filesystem::path> RootPaths(CoverageData const & data);
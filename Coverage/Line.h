@@ -16,38 +16,11 @@ struct Line
 template <>
 struct GLib::Eval::Visitor<Line>
 {
-	static void Visit(Line const & line, std::string const & propertyName, ValueVisitor const & visitor)
-	{
-		if (propertyName == "cover")
-		{
-			return visitor(Value(line.Cover));
-		}
-
-		if (propertyName == "number")
-		{
-			return visitor(Value(line.Number));
-		}
-
-		if (propertyName == "paddedNumber")
-		{
-			return visitor(Value(line.PaddedNumber));
-		}
-
-		if (propertyName == "text")
-		{
-			return visitor(Value(line.Text));
-		}
-
-		if (propertyName == "hasLink")
-		{
-			return visitor(Value(line.HasLink));
-		}
-
-		if (propertyName == "hasNoLink") // todo !${value}
-		{
-			return visitor(Value(!line.HasLink));
-		}
-
-		throw std::runtime_error("Unknown property : '" + propertyName + '\'');
-	}
+	static constexpr std::array Properties {
+		Property<Line> {"cover", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(line.Cover)); }},
+		Property<Line> {"number", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(line.Number)); }},
+		Property<Line> {"paddedNumber", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(line.PaddedNumber)); }},
+		Property<Line> {"text", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(line.Text)); }},
+		Property<Line> {"hasLink", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(line.HasLink)); }},
+		Property<Line> {"hasNoLink", [](Line const & line, ValueVisitor const & visitor) { visitor(Value(!line.HasLink)); }}};
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <GLib/Appender.h>
+
 #include <array>
 #include <ostream>
 
@@ -10,8 +12,19 @@ enum class LineCover : uint8_t
 	NotCovered
 };
 
-inline std::ostream & operator<<(std::ostream & stm, LineCover const & cov)
+inline std::string_view Name(LineCover const cov)
 {
 	constexpr auto values = std::array {std::string_view {}, std::string_view {"cov"}, std::string_view {"ncov"}};
-	return stm << values.at(static_cast<uint8_t>(cov));
+	return values.at(static_cast<uint8_t>(cov));
+}
+
+inline std::ostream & operator<<(std::ostream & stm, LineCover const & cov)
+{
+	return stm << Name(cov);
+}
+
+// written once per line of a report page
+inline void AppendTo(GLib::Util::Appender & out, LineCover const & cov)
+{
+	out.Append(Name(cov));
 }
@@ -0,0 +1,196 @@
+#include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Printer.h>
+#include <GLib/Xml/Stream.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+/*
+malformed input may only fail with std::runtime_error
+input that parses must parse the same when streamed in small chunks
+and must print to a document that parses to the same elements, comments aside
+*/
+
+namespace
+{
+	void Require(bool const value, char const * message)
+	{
+		if (!value)
+		{
+			std::cerr << "Fuzz check failed: " << message << std::endl;
+			std::abort();
+		}
+	}
+
+	// one line per element, decoded, with adjacent text joined and an element without content as empty, so printing does not change it
+	template <typename Elements>
+	std::vector<std::string> Describe(Elements && elements)
+	{
+		std::vector<std::string> values;
+		std::string buffer;
+		auto last = GLib::Xml::ElementType::Comment;
+		for (auto const & element : elements)
+		{
+			auto const type = element.Type();
+			if (type == GLib::Xml::ElementType::Comment)
+			{
+				continue;
+			}
+			if (type == GLib::Xml::ElementType::Close && last == GLib::Xml::ElementType::Open)
+			{
+				values.back().front() = static_cast<char>('0' + static_cast<int>(GLib::Xml::ElementType::Empty));
+				last = GLib::Xml::ElementType::Empty;
+				continue;
+			}
+			if (type == GLib::Xml::ElementType::Text && last == GLib::Xml::ElementType::Text)
+			{
+				values.back() += element.DecodedText(buffer);
+				continue;
+			}
+			last = type;
+			std::string value = std::to_string(static_cast<int>(element.Type()));
+			value += element.QName();
+			value += '|';
+			value += element.NameSpace();
+			value += '|';
+			value += element.DecodedText(buffer);
+			for (auto const & attribute : element.GetAttributes())
+			{
+				value += '|';
+				value += attribute.Name;
+				value += '|';
+				value += attribute.NameSpace;
+				value += '|';
+				value += attribute.DecodedValue(buffer);
+			}
+			values.push_back(std::move(value));
+		}
+		return values;
+	}
+
+	std::string Print(std::string_view const xml)
+	{
+		GLib::Xml::Printer printer {false};
+		std::string buffer;
+		for (auto const & element : GLib::Xml::Holder {xml})
+		{
+			switch (element.Type())
+			{
+				case GLib::Xml::ElementType::Open:
+				case GLib::Xml::ElementType::Empty:
+				{
+					printer.OpenElement(element.QName());
+					for (auto const & attribute : element.IndexedAttributes())
+					{
+						printer.PushAttribute(attribute.QName, attribute.DecodedValue(buffer));
+					}
+					if (element.Type() == GLib::Xml::ElementType::Empty)
+					{
+						printer.CloseElement();
+					}
+					break;
+				}
+
+				case GLib::Xml::ElementType::Close:
+				{
+					printer.CloseElement();
+					break;
+				}
+
+				case GLib::Xml::ElementType::Text:
+				{
+					printer.PushText(element.DecodedText(buffer));
+					break;
+				}
+
+				default:
+				{
+					break;
+				}
+			}
+		}
+		return printer.Release();
+	}
+
+	std::optional<std::vector<std::string>> Parse(std::string_view const xml)
+	{
+		try
+		{
+			return Describe(GLib::Xml::Holder {xml, GLib::Xml::Utf8::Validation::On});
+		}
+		catch (std::runtime_error const &)
+		{
+			return {};
+		}
+	}
+
+	std::optional<std::vector<std::string>> ParseStream(std::string_view const xml, size_t const chunkSize)
+	{
+		try
+		{
+			std::istringstream stream {std::string {xml}};
+			return Describe(GLib::Xml::StreamHolder {GLib::Xml::Utf8::Validation::On, stream, chunkSize});
+		}
+		catch (std::runtime_error const &)
+		{
+			return {};
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const * data, size_t const size)
+{
+	std::string_view const xml {reinterpret_cast<char const *>(data), size}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+	auto const held = Parse(xml);
+	auto const streamed = ParseStream(xml, 3);
+	Require(held.has_value() == streamed.has_value(), "stream and holder disagree on validity");
+	if (!held)
+	{
+		return 0;
+	}
+	Require(*held == *streamed, "stream and holder elements differ");
+
+	auto const printed = Parse(Print(xml));
+	Require(printed.has_value(), "printed document does not parse");
+	Require(*printed == *held, "printed document has different elements");
+	return 0;
+}
+
+#if !defined(GLIB_LIBFUZZER)
+// replays each file given, directories are expanded
+int main(int const argc, char const * const * const argv)
+{
+	std::vector<std::filesystem::path> files;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::filesystem::path const path {argv[i]}; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+		if (std::filesystem::is_directory(path))
+		{
+			for (auto const & entry : std::filesystem::directory_iterator {path})
+			{
+				files.push_back(entry.path());
+			}
+		}
+		else
+		{
+			files.push_back(path);
+		}
+	}
+
+	for (auto const & file : files)
+	{
+		std::ifstream stream {file, std::ios::binary};
+		std::string const data {std::istreambuf_iterator<char> {stream}, std::istreambuf_iterator<char> {}};
+		LLVMFuzzerTestOneInput(reinterpret_cast<uint8_t const *>(data.data()), data.size()); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	}
+	std::cout << "Replayed " << files.size() << " inputs" << std::endl;
+	return 0;
+}
+#endif
@@ -0,0 +1,56 @@
+#include "Allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// only the unaligned forms, the aligned ones keep their own pairing of allocate and free
+namespace
+{
+	std::atomic<uint64_t> count;
+
+	void * Allocate(std::size_t const size)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		if (void * const ptr = std::malloc(size == 0 ? 1 : size))
+		{
+			return ptr;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+uint64_t Allocations::Count()
+{
+	return count.load(std::memory_order_relaxed);
+}
+
+void * operator new(std::size_t const size)
+{
+	return Allocate(size);
+}
+
+void * operator new[](std::size_t const size)
+{
+	return Allocate(size);
+}
+
+void operator delete(void * const ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * const ptr, std::size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void * const ptr, std::size_t /*size*/) noexcept
+{
+	std::free(ptr);
+}
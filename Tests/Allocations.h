@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// global operator new is replaced in Allocations.cpp to count heap allocations, for tests that parse without any
+namespace Allocations
+{
+	[[nodiscard]] uint64_t Count();
+}
@@ -0,0 +1,126 @@
+#include <GLib/Appender.h>
+#include <GLib/Compat.h>
+#include <GLib/Eval/Utils.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+using GLib::Util::Appender;
+
+namespace
+{
+	std::string ReadFile(std::filesystem::path const & path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::ostringstream stm;
+		stm << file.rdbuf();
+		return stm.str();
+	}
+
+	int FileNo(std::FILE * const file)
+	{
+#if defined(_WIN32)
+		return _fileno(file);
+#else
+		return fileno(file);
+#endif
+	}
+
+	template <typename T>
+	std::string Written(T const & value)
+	{
+		std::string result;
+		{
+			Appender out {[&](std::string_view const data) { result.append(data); }};
+			GLib::Eval::Utils::Write(out, value);
+		}
+		return result;
+	}
+}
+
+AUTO_TEST_SUITE(AppenderTests)
+
+AUTO_TEST_CASE(Blocks)
+{
+	std::vector<std::string> blocks;
+	Appender out {[&](std::string_view const data) { blocks.emplace_back(data); }, 4};
+
+	out.Append("ab");
+	out.Append('c');
+	TEST(blocks.empty());
+	TEST(out.Pending() == "abc");
+
+	out.Append("de");
+	out.Append("0123456789");
+	out.Append('x');
+	out.Flush();
+	out.Flush();
+
+	std::vector<std::string> const expected {"abc", "de", "0123456789", "x"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), blocks.begin(), blocks.end());
+	TEST(out.Pending().empty());
+}
+
+AUTO_TEST_CASE(DestructorFlushes)
+{
+	std::ostringstream stm;
+	{
+		Appender out {stm};
+		out.Append("text");
+		TEST(stm.str().empty());
+	}
+	TEST(stm.str() == "text");
+}
+
+AUTO_TEST_CASE(Numbers)
+{
+	// the same text as Eval::Utils::ToString
+	TEST(Written(0) == "0");
+	TEST(Written(-42) == std::to_string(-42));
+	TEST(Written(std::numeric_limits<int64_t>::min()) == std::to_string(std::numeric_limits<int64_t>::min()));
+	TEST(Written(std::numeric_limits<uint64_t>::max()) == std::to_string(std::numeric_limits<uint64_t>::max()));
+	TEST(Written(uint8_t {200}) == "200");
+	TEST(Written(1.5F) == std::to_string(1.5F));
+	TEST(Written(-2.25e10) == std::to_string(-2.25e10));
+	TEST(Written(std::numeric_limits<double>::max()) == std::to_string(std::numeric_limits<double>::max()));
+	TEST(Written(0.0000005) == std::to_string(0.0000005));
+	TEST(Written(true) == "true");
+	TEST(Written(std::string {"value"}) == "value");
+	TEST(Written("literal") == "literal");
+}
+
+AUTO_TEST_CASE(Targets)
+{
+	auto const path = std::filesystem::temp_directory_path() / (std::to_string(GLib::Compat::ProcessId()) + "Appender.txt");
+	std::string const content = std::string(100, 'a') + "end";
+
+	std::FILE * const file = std::fopen(path.string().c_str(), "wb");
+	BOOST_REQUIRE(file != nullptr);
+	{
+		Appender out {file, 16};
+		out.Append(content);
+		out.Append(123);
+	}
+	TEST(std::fclose(file) == 0);
+	TEST(ReadFile(path) == content + "123");
+
+	std::FILE * const descriptorFile = std::fopen(path.string().c_str(), "wb");
+	BOOST_REQUIRE(descriptorFile != nullptr);
+	{
+		Appender out {FileNo(descriptorFile), 16};
+		out.Append(content);
+		out.Flush();
+	}
+	TEST(std::fclose(descriptorFile) == 0);
+	TEST(ReadFile(path) == content);
+
+	std::filesystem::remove(path);
+}
+
+AUTO_TEST_SUITE_END()
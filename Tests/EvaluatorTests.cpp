@@ -29,6 +29,53 @@ AUTO_TEST_CASE(AddStruct)
 	TEST(ageValue == "999");
 }
 
+AUTO_TEST_CASE(Path)
+{
+	GLib::Eval::Evaluator evaluator;
+	User const user {"Zardoz", U16(999), {}};
+	evaluator.Set("user", user);
+
+	GLib::Eval::Path const path = GLib::Eval::SplitPath("user.name");
+	TEST(path.size() == 2U);
+	TEST(evaluator.Evaluate(path) == "Zardoz");
+	TEST(evaluator.Evaluate(GLib::Eval::Path {"user", "age"}) == "999");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(evaluator.Evaluate(GLib::Eval::Path {"nobody"})); }, "Value not found : nobody");
+	GLIB_CHECK_LOGIC_EXCEPTION({ static_cast<void>(evaluator.Evaluate(GLib::Eval::Path {})); }, "Path is empty");
+}
+
+AUTO_TEST_CASE(Binding)
+{
+	std::vector<User> const users {{"Fred", U16(42), {}}, {"Jim", U16(43), {}}};
+	GLib::Eval::Evaluator evaluator;
+	evaluator.SetCollection("users", users);
+
+	GLib::Eval::Binding const name = evaluator.Bind({"user", "name"});
+	TEST(static_cast<size_t>(evaluator.Bind(GLib::Eval::SplitPath("user.name"))) == static_cast<size_t>(name));
+	GLib::Eval::Binding const age = evaluator.Bind({"user", "age"});
+	GLib::Eval::Variable const user = evaluator.GetVariable("user");
+
+	std::string value;
+	evaluator.ForEach(evaluator.Bind({"users"}),
+										[&](GLib::Eval::ValueBase const & item)
+										{
+											evaluator.Push(user, item);
+											value += evaluator.Evaluate(name) + evaluator.Evaluate(age);
+											evaluator.Pop(user);
+										});
+	TEST(value == "Fred42Jim43");
+
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(evaluator.Evaluate(name)); }, "Value not found : user");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ evaluator.Pop(user); }, "Local value not found : user");
+
+	// a step sees a different type
+	evaluator.Set("user", Struct {{"NestedValue"}});
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(evaluator.Evaluate(name)); }, "Unknown property : 'name'");
+	TEST(evaluator.Evaluate(evaluator.Bind({"user", "Nested"})) == "NestedValue");
+	evaluator.Set("user", users[1]);
+	TEST(evaluator.Evaluate(name) == "Jim");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(evaluator.Evaluate(evaluator.Bind({"user", "size"}))); }, "Unknown property : 'size'");
+}
+
 AUTO_TEST_CASE(NestedStruct)
 {
 	GLib::Eval::Evaluator evaluator;
@@ -190,6 +237,13 @@ AUTO_TEST_CASE(Bool)
 	evaluator.Set("valueFalse", false);
 	TEST("true" == evaluator.Evaluate("valueTrue"));
 	TEST("false" == evaluator.Evaluate("valueFalse"));
+
+	TEST(evaluator.Condition(evaluator.Bind({"valueTrue"})));
+	TEST(!evaluator.Condition(evaluator.Bind({"valueFalse"})));
+	evaluator.Set("text", std::string {"true"});
+	TEST(evaluator.Condition(evaluator.Bind({"text"})));
+	evaluator.Set("number", 1);
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(evaluator.Condition(evaluator.Bind({"number"}))); }, "Expected boolean value, got: 1");
 }
 
 AUTO_TEST_SUITE_END()
\ No newline at end of file
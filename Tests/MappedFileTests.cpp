@@ -0,0 +1,94 @@
+#include <GLib/Cpp/Iterator.h>
+#include <GLib/MappedFile.h>
+#include <GLib/Scope.h>
+#include <GLib/Xml/Iterator.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+#include <fstream>
+
+using GLib::MappedFile;
+
+namespace
+{
+	std::filesystem::path WriteTempFile(std::string_view const name, std::string_view const content)
+	{
+		auto path = std::filesystem::temp_directory_path() / (std::to_string(GLib::Compat::ProcessId()) + std::string(name));
+		std::ofstream file(path, std::ios::binary);
+		file << content;
+		return path;
+	}
+
+	bool Within(std::string_view const value, std::string_view const outer)
+	{
+		return value.data() >= outer.data() && value.data() + value.size() <= outer.data() + outer.size();
+	}
+}
+
+AUTO_TEST_SUITE(MappedFileTests)
+
+AUTO_TEST_CASE(MappedXml)
+{
+	std::string_view constexpr content = "<xml a='1'><sub>text</sub></xml>";
+	auto const path = WriteTempFile("MappedXml.xml", content);
+	auto const remove = GLib::Detail::Scope([&] { std::filesystem::remove(path); });
+
+	MappedFile const file {path};
+	TEST(file.View() == content);
+	TEST(file.Size() == content.size());
+
+	size_t count {};
+	for (auto const & e : GLib::Xml::Holder {file})
+	{
+		TEST(Within(e.Type() == GLib::Xml::ElementType::Text ? e.Text() : e.OuterXml(), file));
+		++count;
+	}
+	TEST(count == 5U);
+	static_cast<void>(remove);
+}
+
+AUTO_TEST_CASE(MappedCpp)
+{
+	std::string_view constexpr content = "int main() { return 0; } // comment\n";
+	auto const path = WriteTempFile("MappedCpp.cpp", content);
+	auto const remove = GLib::Detail::Scope([&] { std::filesystem::remove(path); });
+
+	MappedFile const file {path};
+	std::string joined;
+	for (auto const & [state, value] : GLib::Cpp::Holder {file})
+	{
+		static_cast<void>(state);
+		TEST(Within(value, file));
+		joined += value;
+	}
+	TEST(joined == content);
+	static_cast<void>(remove);
+}
+
+AUTO_TEST_CASE(MoveAndEmpty)
+{
+	auto const path = WriteTempFile("Empty.txt", {});
+	auto const remove = GLib::Detail::Scope([&] { std::filesystem::remove(path); });
+
+	MappedFile file {path};
+	TEST(file.View().empty());
+
+	auto const otherPath = WriteTempFile("Other.txt", "other");
+	auto const removeOther = GLib::Detail::Scope([&] { std::filesystem::remove(otherPath); });
+	MappedFile other {otherPath};
+	file = std::move(other);
+	TEST(file.View() == "other");
+	TEST(other.View().empty()); // NOLINT(bugprone-use-after-move) moved from state is defined
+	static_cast<void>(remove);
+	static_cast<void>(removeOther);
+}
+
+AUTO_TEST_CASE(MissingFileThrows)
+{
+	auto const path = std::filesystem::temp_directory_path() / "GLibMappedFileTests.missing";
+	CHECK_EXCEPTION({ MappedFile const file {path}; }, std::runtime_error, [](std::runtime_error const &) { return true; });
+}
+
+AUTO_TEST_SUITE_END()
@@ -0,0 +1,41 @@
+#include <GLib/ParallelFor.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+#include <numeric>
+
+AUTO_TEST_SUITE(ParallelForTests)
+
+AUTO_TEST_CASE(EachIndexOnce)
+{
+	for (size_t const threads : {0, 1, 3, 8})
+	{
+		std::vector<std::atomic<int>> visits(1000);
+		GLib::ParallelFor(visits.size(), threads, [&](size_t const index) { ++visits[index]; });
+		TEST(std::all_of(visits.begin(), visits.end(), [](auto const & value) { return value == 1; }));
+	}
+}
+
+AUTO_TEST_CASE(NoWork)
+{
+	GLib::ParallelFor(0, 4, [](size_t) { FAIL("unexpected call"); });
+}
+
+AUTO_TEST_CASE(FirstExceptionRethrown)
+{
+	std::atomic<size_t> calls {};
+	auto const function = [&](size_t const index)
+	{
+		++calls;
+		if (index == 10)
+		{
+			throw std::runtime_error("index 10");
+		}
+	};
+	GLIB_CHECK_RUNTIME_EXCEPTION(GLib::ParallelFor(10000, 4, function), "index 10");
+	TEST(calls < 10000U);
+}
+
+AUTO_TEST_SUITE_END()
@@ -0,0 +1,162 @@
+#include <GLib/Html/RenderBatch.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestStructs.h"
+#include "TestUtils.h"
+
+#include <fstream>
+#include <sstream>
+
+using GLib::Html::CompiledTemplate;
+using GLib::Html::RenderBatch;
+using GLib::Html::RenderJob;
+
+namespace
+{
+	auto const * usersXml = R"(<xml xmlns:gl='glib'>
+<gl:block each="user : ${users}">
+	<User name='${user.name}' age='${user.age}'/>
+</gl:block>
+</xml>)";
+
+	std::string ReadFile(std::filesystem::path const & path)
+	{
+		std::ifstream file(path);
+		std::ostringstream stm;
+		stm << file.rdbuf();
+		return stm.str();
+	}
+
+	std::filesystem::path TempDirectory()
+	{
+		return std::filesystem::temp_directory_path() / (std::to_string(GLib::Compat::ProcessId()) + "RenderBatch");
+	}
+
+	// job i has i users, the data is owned by the closure
+	std::vector<RenderJob> Jobs(CompiledTemplate const & users, CompiledTemplate const & count, std::filesystem::path const & directory,
+															size_t const jobCount)
+	{
+		std::vector<RenderJob> jobs;
+		for (size_t i = 0; i < jobCount; ++i)
+		{
+			auto data = std::make_shared<std::vector<User>>();
+			for (size_t j = 0; j < i; ++j)
+			{
+				data->push_back({"User" + std::to_string(j), static_cast<uint16_t>(j), {}});
+			}
+
+			auto const name = "page" + std::to_string(i);
+			jobs.push_back({[data, i](GLib::Eval::Evaluator & evaluator)
+											{
+												evaluator.SetCollection("users", *data);
+												evaluator.Set("count", i);
+											},
+											{{&users, directory / "sub" / (name + ".html")}, {&count, directory / (name + ".count.html")}}});
+		}
+		return jobs;
+	}
+}
+
+AUTO_TEST_SUITE(RenderBatchTests)
+
+AUTO_TEST_CASE(SameForAnyThreadCount)
+{
+	CompiledTemplate const users {usersXml};
+	CompiledTemplate const count {"<p>${count}</p>"};
+	auto const directory = TempDirectory();
+	constexpr size_t jobCount = 40;
+
+	std::vector<std::string> first;
+	for (size_t const threads : {1, 4, 0})
+	{
+		std::filesystem::remove_all(directory);
+		auto const jobs = Jobs(users, count, directory, jobCount);
+		auto const timings = RenderBatch(jobs, threads);
+		TEST(timings.size() == jobCount);
+
+		std::vector<std::string> pages;
+		for (size_t i = 0; i < jobCount; ++i)
+		{
+			TEST(timings[i].Ok());
+			size_t bytes {};
+			for (auto const & page : jobs[i].Pages)
+			{
+				pages.push_back(ReadFile(page.Path));
+				bytes += pages.back().size();
+			}
+			TEST(timings[i].Bytes == bytes);
+		}
+		if (first.empty())
+		{
+			first = pages;
+		}
+		CHECK_EQUAL_COLLECTIONS(first.begin(), first.end(), pages.begin(), pages.end());
+	}
+
+	GLib::Eval::Evaluator evaluator;
+	std::vector<User> const two {{"User0", 0, {}}, {"User1", 1, {}}};
+	evaluator.SetCollection("users", two);
+	std::ostringstream expected;
+	GLib::Html::Generate(evaluator, users, expected);
+	TEST(first[4] == expected.str());
+	TEST(first[5] == "<p>2</p>");
+
+	std::filesystem::remove_all(directory);
+}
+
+AUTO_TEST_CASE(ErrorsFailOnlyTheirJob)
+{
+	CompiledTemplate const page {"<p>${value}</p>"};
+	auto const directory = TempDirectory();
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory / "taken.html");
+
+	std::vector<RenderJob> jobs;
+	jobs.push_back({[](GLib::Eval::Evaluator & evaluator) { evaluator.Set("value", 1); }, {{&page, directory / "ok.html"}}});
+	jobs.push_back({[](GLib::Eval::Evaluator &) { throw std::runtime_error("No data"); }, {{&page, directory / "prepare.html"}}});
+	jobs.push_back({{}, {{&page, directory / "render.html"}}});
+	jobs.push_back({[](GLib::Eval::Evaluator & evaluator) { evaluator.Set("value", 2); }, {{&page, directory / "taken.html"}}});
+
+	auto const timings = RenderBatch(jobs, 2);
+	TEST(timings[0].Ok());
+	TEST(ReadFile(directory / "ok.html") == "<p>1</p>");
+	TEST(timings[1].Error == "No data");
+	TEST(!std::filesystem::exists(directory / "prepare.html"));
+	TEST(timings[2].Error == "Value not found : value");
+	TEST(timings[3].Error.starts_with("Unable to create file : "));
+	TEST(!timings[0].Exception);
+	GLIB_CHECK_RUNTIME_EXCEPTION({ std::rethrow_exception(timings[1].Exception); }, "No data");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ std::rethrow_exception(timings[3].Exception); }, timings[3].Error);
+
+	TEST(RenderBatch({}).empty());
+	std::filesystem::remove_all(directory);
+}
+
+AUTO_TEST_CASE(JobDataReleasedOnceRendered)
+{
+	CompiledTemplate const page {"<p>${value}</p>"};
+	auto const directory = TempDirectory();
+
+	auto data = std::make_shared<int>(1);
+	std::weak_ptr<int> const weak = data;
+	bool released {};
+
+	std::vector<RenderJob> jobs;
+	jobs.push_back({[data = std::move(data)](GLib::Eval::Evaluator & evaluator) { evaluator.Set("value", *data); }, {{&page, directory / "first.html"}}});
+	jobs.push_back({[&](GLib::Eval::Evaluator & evaluator)
+									{
+										released = weak.expired();
+										evaluator.Set("value", 2);
+									},
+									{{&page, directory / "second.html"}}});
+
+	auto const timings = RenderBatch(std::move(jobs), 1); // in order
+	TEST(timings[0].Ok());
+	TEST(timings[1].Ok());
+	TEST(released);
+	TEST(ReadFile(directory / "first.html") == "<p>1</p>");
+	std::filesystem::remove_all(directory);
+}
+
+AUTO_TEST_SUITE_END()
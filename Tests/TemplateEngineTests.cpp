@@ -1,5 +1,6 @@
 
 #include <GLib/Html/TemplateEngine.h>
+#include <GLib/ParallelFor.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -7,7 +8,31 @@
 #include "TestUtils.h"
 
 using GLib::Eval::Evaluator;
+using GLib::Html::CompiledTemplate;
 using GLib::Html::Generate;
+using GLib::Html::TemplateCache;
+
+namespace
+{
+	auto const * usersXml = R"(<xml xmlns:gl='glib'>
+<gl:block each="user : ${users}">
+	<User name='${user.name}' age='${user.age}'>
+<gl:block each="hobby : ${user.hobbies}">
+		<Hobby value='${hobby}'/>
+</gl:block>
+	</User>
+</gl:block>
+</xml>)";
+
+	std::string Render(std::vector<User> const & users, CompiledTemplate const & compiled)
+	{
+		Evaluator evaluator;
+		evaluator.SetCollection("users", users);
+		std::ostringstream stm;
+		Generate(evaluator, compiled, stm);
+		return stm.str();
+	}
+}
 
 AUTO_TEST_SUITE(TemplateEngineTests)
 
@@ -291,6 +316,100 @@ AUTO_TEST_CASE(IfEach)
 	TEST(stm.str() == expectedNo);
 }
 
+AUTO_TEST_CASE(PlaceholderSyntax)
+{
+	Evaluator evaluator;
+	evaluator.Set<std::string>("a", "1");
+	evaluator.Set<std::string>("b", "2");
+
+	std::ostringstream stm;
+	Generate(evaluator, "<xml v='${a}${b}' w='$${a}}' x='${ a} ${} ${-} ${b'>${a}</xml>", stm);
+	TEST(stm.str() == "<xml v='12' w='$1}' x='${ a} ${} ${-} ${b'>1</xml>");
+
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Generate(evaluator, "<xml xmlns:gl='glib'><p gl:if='a'/></xml>", stm); }, "Error in if value : a");
+}
+
+AUTO_TEST_CASE(Compiled)
+{
+	std::vector<User> const fred {{"Fred", 42, {"FC00", "FC01"}}};
+	std::vector<User> const users {{"Jim", 43, {"FD00"}}, {"Sheila", 44, {}}};
+
+	CompiledTemplate const compiled {usersXml};
+	for (auto const & value : {fred, users, fred})
+	{
+		Evaluator evaluator;
+		evaluator.SetCollection("users", value);
+		std::ostringstream expected;
+		Generate(evaluator, usersXml, expected);
+
+		TEST(Render(value, compiled) == expected.str());
+	}
+}
+
+AUTO_TEST_CASE(CompiledShared)
+{
+	std::vector<User> const users {{"Fred", 42, {"FC00"}}, {"Jim", 43, {"FD00"}}};
+	CompiledTemplate const compiled {usersXml};
+	std::string const expected = Render(users, compiled);
+
+	std::vector<std::string> results(200);
+	GLib::ParallelFor(results.size(), 4, [&](size_t const index) { results[index] = Render(users, compiled); });
+	for (auto const & result : results)
+	{
+		TEST(result == expected);
+	}
+}
+
+AUTO_TEST_CASE(Appender)
+{
+	std::vector<User> const users {{"Fred", 42, {"FC00"}}, {"Jim", 43, {"FD00", "FD01"}}};
+	CompiledTemplate const compiled {usersXml};
+
+	std::string value;
+	size_t blocks {};
+	{
+		GLib::Util::Appender out {[&](std::string_view const data)
+															{
+																value.append(data);
+																++blocks;
+															},
+															16};
+		Evaluator evaluator;
+		evaluator.SetCollection("users", users);
+		Generate(evaluator, compiled, out);
+		out.Flush();
+	}
+	TEST(value == Render(users, compiled));
+	TEST(blocks > 1U);
+}
+
+AUTO_TEST_CASE(Cache)
+{
+	TemplateCache cache;
+	CompiledTemplate const & added = cache.Add("users", usersXml);
+	TEST(&cache.Get("users") == &added);
+	TEST(cache.Find("other") == nullptr);
+
+	size_t loads {};
+	auto const load = [&]
+	{
+		++loads;
+		return std::string {"<xml a='${name}'/>"};
+	};
+	CompiledTemplate const & other = cache.Get("other", load);
+	TEST(&cache.Get("other", load) == &other);
+	TEST(loads == 1U);
+
+	Evaluator evaluator;
+	evaluator.Set<std::string>("name", "fred");
+	std::ostringstream stm;
+	Generate(evaluator, cache.Get("other"), stm);
+	TEST(stm.str() == "<xml a='fred'/>");
+
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(cache.Add("users", "<xml/>")); }, "Template already exists : users");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(cache.Get("missing")); }, "Template not found : missing");
+}
+
 AUTO_TEST_CASE(TestUtilsTest1) // move
 {
 	std::ostringstream stm;
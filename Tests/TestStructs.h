@@ -42,22 +42,10 @@ struct HasNoToString
 template <>
 struct GLib::Eval::Visitor<User>
 {
-	static void Visit(User const & user, std::string const & propertyName, ValueVisitor const & f)
-	{
-		if (propertyName == "name")
-		{
-			return f(Value(user.Name));
-		}
-		if (propertyName == "age")
-		{
-			return f(Value(user.Age));
-		}
-		if (propertyName == "hobbies")
-		{
-			return f(MakeCollection(user.Hobbies));
-		}
-		throw std::runtime_error(std::string("Unknown property : '") + propertyName + '\''); // bool return?
-	}
+	static constexpr std::array Properties {
+		Property<User> {"name", [](User const & user, ValueVisitor const & visitor) { visitor(Value(user.Name)); }},
+		Property<User> {"age", [](User const & user, ValueVisitor const & visitor) { visitor(Value(user.Age)); }},
+		Property<User> {"hobbies", [](User const & user, ValueVisitor const & visitor) { visitor(MakeCollection(user.Hobbies)); }}};
 };
 
 template <>
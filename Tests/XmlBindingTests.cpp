@@ -0,0 +1,146 @@
+#include <GLib/Xml/Binding.h>
+#include <GLib/Xml/Stream.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+namespace Bind = GLib::Xml::Bind;
+using GLib::Xml::Holder;
+using GLib::Xml::StreamHolder;
+
+namespace
+{
+	struct Price
+	{
+		std::string currency;
+		double value {};
+	};
+
+	struct Item
+	{
+		int id {};
+		std::string kind;
+		std::string title;
+		std::optional<Price> price;
+		std::vector<std::string> tags;
+		bool active {};
+	};
+
+	struct Feed
+	{
+		std::string version;
+		std::vector<Item> items;
+	};
+
+	constexpr std::string_view x = "urn:x";
+
+	constexpr Bind::Schema priceSchema {Bind::Attribute("currency", &Price::currency), Bind::Text(&Price::value)};
+
+	constexpr Bind::Schema itemSchema {Bind::Attribute("id", &Item::id),
+																		 Bind::Attribute({x, "kind"}, &Item::kind),
+																		 Bind::Child("title", &Item::title),
+																		 Bind::Child({x, "price"}, &Item::price, priceSchema),
+																		 Bind::Child("tag", &Item::tags),
+																		 Bind::Child("active", &Item::active)};
+
+	constexpr Bind::Schema feedSchema {Bind::Attribute("version", &Feed::version), Bind::Child("item", &Feed::items, itemSchema)};
+
+	constexpr std::string_view feedXml = R"(<?xml version="1.0"?>
+<!-- feed -->
+<feed xmlns:x='urn:x' version="1.2" unknown='u'>
+	<item id=' 7 ' x:kind="record" kind='ignored'>
+		<title>Fish &amp; chips</title>
+		<x:price currency='GBP'>9.99</x:price>
+		<price currency='USD'>1</price>
+		<tag>a</tag><tag>b<!-- split -->c</tag><tag/>
+		<active>true</active>
+		<extra><title>skipped</title></extra>
+	</item>
+	<item id='8'/>
+</feed>
+)";
+
+	void CheckFeed(Feed const & feed)
+	{
+		TEST(feed.version == "1.2");
+		TEST(feed.items.size() == 2U);
+
+		Item const & first = feed.items[0];
+		TEST(first.id == 7);
+		TEST(first.kind == "record");
+		TEST(first.title == "Fish & chips");
+		TEST(first.price.has_value());
+		TEST(first.price->currency == "GBP");
+		TEST(first.price->value == 9.99);
+		std::vector<std::string> const tags {"a", "bc", ""};
+		CHECK_EQUAL_COLLECTIONS(tags.begin(), tags.end(), first.tags.begin(), first.tags.end());
+		TEST(first.active);
+
+		Item const & second = feed.items[1];
+		TEST(second.id == 8);
+		TEST(second.title.empty());
+		TEST(!second.price.has_value());
+	}
+}
+
+AUTO_TEST_SUITE(XmlBindingTests)
+
+AUTO_TEST_CASE(ReadNested)
+{
+	CheckFeed(Bind::Read("feed", feedSchema, Holder {feedXml}));
+
+	std::istringstream stream {std::string(feedXml)};
+	CheckFeed(Bind::Read("feed", feedSchema, StreamHolder {stream, 5}));
+}
+
+AUTO_TEST_CASE(DefaultNameSpace)
+{
+	struct Value
+	{
+		int number {};
+	};
+	constexpr Bind::Schema qualified {Bind::Child({"urn:d", "n"}, &Value::number)};
+	constexpr Bind::Schema unqualified {Bind::Child("n", &Value::number)};
+
+	constexpr std::string_view xml = "<v xmlns='urn:d'><n>3</n></v>";
+	TEST(Bind::Read({"urn:d", "v"}, qualified, Holder {xml}).number == 3);
+	TEST(Bind::Read({"urn:d", "v"}, unqualified, Holder {xml}).number == 0);
+}
+
+AUTO_TEST_CASE(SplitText)
+{
+	Item const item = Bind::Read("item", itemSchema, Holder {"<item xmlns:x='urn:x'><x:price currency='GBP'>9<!-- c -->.9<i/>9</x:price>"
+																													"<title>a<!-- c -->b</title><active> tr<!-- c -->ue </active></item>"});
+	TEST(item.price->value == 9.99);
+	TEST(item.title == "ab");
+	TEST(item.active);
+
+	Price const price = Bind::Read("price", priceSchema, Holder {"<price>1<!-- c -->2</price>"});
+	TEST(price.value == 12);
+}
+
+AUTO_TEST_CASE(Errors)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<item id='x'/>"})); }, "Invalid value for id: 'x'");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<item id='1 2'/>"})); }, "Invalid value for id: '1 2'");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<item><active>yes</active></item>"})); },
+															 "Invalid value for active: 'yes'");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<item><active/></item>"})); }, "Invalid value for active: ''");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<other id='1'/>"})); },
+															 "Root element mismatch: other != item");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read({x, "item"}, itemSchema, Holder {"<item id='1'/>"})); },
+															 "Root element mismatch: item != {urn:x}item");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Bind::Read("item", itemSchema, Holder {"<item></item><item/>"})); },
+															 "Extra content at document end");
+
+	struct Twice
+	{
+		int a {};
+		int b {};
+	};
+	GLIB_CHECK_LOGIC_EXCEPTION({ static_cast<void>(Bind::Schema {Bind::Attribute("a", &Twice::a), Bind::Attribute("a", &Twice::b)}); },
+														 "Name bound twice");
+}
+
+AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+#include <GLib/Xml/Document.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+using GLib::Xml::Document;
+using GLib::Xml::ElementType;
+
+AUTO_TEST_SUITE(XmlDocumentTests)
+
+AUTO_TEST_CASE(Structure)
+{
+	std::string_view constexpr xml = R"(<!-- c --><root a='1'><x:one xmlns:x='urn:x' b="2"/>text<two><three/></two><one/></root>)";
+	Document const doc {xml};
+
+	TEST(doc.Size() == 7U);
+	auto const root = doc.Root();
+	TEST(root == 1U);
+	TEST((doc.Get(0).Type() == ElementType::Comment));
+	TEST(doc.Get(0).Text() == "<!-- c -->");
+	TEST(doc.Get(0).NextSibling() == root);
+
+	auto const & rootNode = doc.Get(root);
+	TEST(rootNode.Name() == "root");
+	TEST(rootNode.Parent() == Document::None);
+	TEST(rootNode.NextSibling() == Document::None);
+
+	std::vector<std::string_view> children;
+	for (auto child = rootNode.FirstChild(); child != Document::None; child = doc.Get(child).NextSibling())
+	{
+		TEST(doc.Get(child).Parent() == root);
+		children.push_back(doc.Get(child).Type() == ElementType::Text ? doc.Get(child).Text() : doc.Get(child).QName());
+	}
+	std::vector<std::string_view> const expected {"x:one", "text", "two", "one"};
+	CHECK_EQUAL_COLLECTIONS(children.begin(), children.end(), expected.begin(), expected.end());
+
+	auto const two = doc.Child(root, "two");
+	TEST(doc.Get(doc.Child(two, "three")).Parent() == two);
+	TEST(doc.Child(two, "missing") == Document::None);
+}
+
+AUTO_TEST_CASE(ChildByNameSpace)
+{
+	Document const doc {"<root xmlns:x='urn:x'><x:one/><one/><one/></root>"};
+	auto const root = doc.Root();
+
+	auto const first = doc.Child(root, "one");
+	TEST(doc.Get(first).QName() == "one");
+	auto const qualified = doc.Child(root, "one", "urn:x");
+	TEST(doc.Get(qualified).QName() == "x:one");
+	TEST(doc.ChildInAnyNameSpace(root, "one") == qualified);
+	TEST(doc.Child(root, "root") == Document::None);
+
+	Document const defaulted {"<root xmlns='urn:d'><one/></root>"};
+	TEST(defaulted.Child(defaulted.Root(), "one") == Document::None);
+	TEST(defaulted.Child(defaulted.Root(), "one", "urn:d") == defaulted.ChildInAnyNameSpace(defaulted.Root(), "one"));
+
+	auto const next = doc.NextNamed(first);
+	TEST(doc.Get(next).QName() == "one");
+	TEST(next > first);
+	TEST(doc.NextNamed(qualified) == Document::None);
+	TEST(doc.NextNamed(next) == Document::None);
+}
+
+AUTO_TEST_CASE(AttributeLookup)
+{
+	Document const doc {"<root xmlns:x='urn:x' a='1' x:a='2' e='&amp;'/>"};
+	auto const root = doc.Root();
+
+	TEST(doc.Attributes(root).size() == 3U);
+	TEST((doc.AttributeValue(root, "a") == "1"));
+	TEST((doc.AttributeValue(root, "a", "urn:x") == "2"));
+	TEST((doc.AttributeValue(root, "e") == "&amp;"));
+	TEST(!doc.AttributeValue(root, "b").has_value());
+}
+
+AUTO_TEST_CASE(NameSpaceEntities)
+{
+	std::string_view constexpr xml = "<r xmlns='a&amp;b'><c xmlns:x='p&lt;q' x:y='1'/></r>";
+	auto const check = [](Document const & doc)
+	{
+		auto const root = doc.Root();
+		TEST(doc.Get(root).NameSpace() == "a&b");
+		auto const child = doc.Child(root, "c", "a&b");
+		TEST(doc.Get(child).NameSpace() == "a&b");
+		TEST((doc.AttributeValue(child, "y", "p<q") == "1"));
+	};
+
+	Document const doc {xml};
+	check(doc);
+
+	std::optional<Document> held;
+	{
+		GLib::Xml::Holder holder {xml};
+		held.emplace(holder);
+	}
+	Document const moved {std::move(*held)};
+	held.reset();
+	check(moved);
+}
+
+AUTO_TEST_CASE(Memory)
+{
+	Document const doc {"<root><a/><b/></root>"};
+	TEST(doc.MemoryUsage() >= 3 * sizeof(Document::Node));
+	TEST(doc.BytesPerNode() >= static_cast<double>(sizeof(Document::Node)));
+}
+
+AUTO_TEST_CASE(ParserErrors)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION(Document {"<root><a></b></root>"}, "Element mismatch: b != a, at line: 0, offset: 13");
+}
+
+AUTO_TEST_SUITE_END()
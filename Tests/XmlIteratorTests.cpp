@@ -1,18 +1,28 @@
 
 #include <GLib/Xml/Printer.h>
+#include <GLib/Xml/Stream.h>
+#include <GLib/Xml/Subtrees.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include "Allocations.h"
 #include "TestUtils.h"
 #include "XmlTestUtils.h"
 
+#include <memory_resource>
+
 using GLib::Xml::Attribute;
 using GLib::Xml::Attributes;
 using GLib::Xml::Element;
 using GLib::Xml::ElementType;
+using GLib::Xml::ForEachSubtree;
 using GLib::Xml::Holder;
 using GLib::Xml::Parse;
+using GLib::Xml::ParseStream;
+using GLib::Xml::ParseSubtrees;
 using GLib::Xml::Printer;
+using GLib::Xml::StreamHolder;
+using GLib::Xml::Subtrees;
 
 AUTO_TEST_SUITE(XmlStateEngineTests)
 
@@ -148,12 +158,76 @@ AUTO_TEST_CASE(XmlDeclMustBeFirst)
 	GLIB_CHECK_RUNTIME_EXCEPTION({ Parse(xml); }, "Illegal character: '?' (0x3f) at line: 1, offset: 1");
 }
 
-AUTO_TEST_CASE(DefaultNameSpaceToDo)
+AUTO_TEST_CASE(DefaultNameSpace)
 {
 	Holder xml {R"(<xml xmlns='foo'/>)"};
 
-	std::vector<Element> expected {{"xml", "xml", "", ElementType::Empty, {}}};
+	std::vector<Element> expected {{"xml", "xml", "foo", ElementType::Empty, {}}};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
+	CHECK(xml.begin()->GetAttributes().begin() == xml.begin()->GetAttributes().end());
+}
+
+AUTO_TEST_CASE(DefaultNameSpaceScope)
+{
+	Holder xml {R"(<a xmlns='ns' at='1'><b><c xmlns='inner'/><d xmlns=''/></b><p:e xmlns:p='p-ns'/></a>)"};
+
+	std::vector<Element> expected {
+		{"a", "a", "ns", ElementType::Open, {}},				{"b", "b", "ns", ElementType::Open, {}}, {"c", "c", "inner", ElementType::Empty, {}},
+		{"d", "d", "", ElementType::Empty, {}},					{"b", "b", "ns", ElementType::Close, {}}, {"p:e", "e", "p-ns", ElementType::Empty, {}},
+		{"a", "a", "ns", ElementType::Close, {}},
+	};
 	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
+
+	// unprefixed attributes are not in the default namespace
+	std::vector<Attribute> const attributes {{"at", "1", "", "at='1'"}};
+	Holder single {"<a xmlns='ns' at='1'/>"};
+	auto const root = single.begin();
+	CHECK_EQUAL_COLLECTIONS(attributes.begin(), attributes.end(), root->GetAttributes().begin(), root->GetAttributes().end());
+}
+
+AUTO_TEST_CASE(NameSpaceOverflow)
+{
+	std::string xml;
+	for (size_t i = 0; i < 20; ++i)
+	{
+		xml += "<p" + std::to_string(i) + ":e xmlns:p" + std::to_string(i) + "='ns" + std::to_string(i) + "' xmlns:q='q" + std::to_string(i) + "'>";
+	}
+	xml += "<q:leaf/>";
+	for (size_t i = 20; i-- != 0;)
+	{
+		xml += "</p" + std::to_string(i) + ":e>";
+	}
+
+	for (size_t const chunkSize : {1, 5, 4096})
+	{
+		std::istringstream stream {xml};
+		StreamHolder streamed {stream, chunkSize};
+		Holder held {xml};
+		CHECK_EQUAL_COLLECTIONS(held.begin(), held.end(), streamed.begin(), streamed.end());
+	}
+
+	std::vector<std::string_view> nameSpaces;
+	for (auto const & e : Holder {xml})
+	{
+		nameSpaces.push_back(e.NameSpace());
+	}
+	TEST(nameSpaces[19] == "ns19");
+	TEST(nameSpaces[20] == "q19");
+	TEST(nameSpaces[21] == "ns19");
+	TEST(nameSpaces[40] == "ns0");
+}
+
+AUTO_TEST_CASE(NameSpaceValueWithEntity)
+{
+	std::string const xml = "<a xmlns='x&amp;y'><b xmlns=\"&lt;z\"/></a>";
+
+	std::vector<std::string> nameSpaces;
+	for (auto const & e : Holder {xml})
+	{
+		nameSpaces.emplace_back(e.NameSpace());
+	}
+	std::vector<std::string> const expected {"x&y", "<z", "x&y"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), nameSpaces.begin(), nameSpaces.end());
 }
 
 AUTO_TEST_CASE(NameSpace)
@@ -400,6 +474,72 @@ AUTO_TEST_CASE(ErrorMeansError)
 	TEST(engine.GetState() == GLib::Xml::State::Error);
 }
 
+AUTO_TEST_CASE(StateSequence)
+{
+	using GLib::Xml::State;
+
+	std::string_view const xml = R"(<?xml version="1.0"?> <!DOCTYPE x><!-- c- --><a b='"1' c = "&lt;'"><![CDATA[]x]] ]]>t&amp;<e/></a >)";
+
+	std::vector<State> const expected {
+		State::ElementStart, State::XmlDeclaration, State::EmptyElement, State::Start, State::ElementStart,
+		State::Bang, State::DocTypeDecl, State::Start, State::ElementStart, State::Bang,
+		State::CommentStartDash, State::Comment, State::CommentEndDash, State::Comment, State::CommentEndDash,
+		State::CommentEnd, State::Start, State::ElementStart, State::ElementName, State::AttributeSpace,
+		State::AttributeName, State::AttributeValueStart, State::AttributeValue, State::AttributeEnd, State::AttributeSpace,
+		State::AttributeName, State::AttributeNameSpace, State::AttributeValueStart, State::AttributeValue, State::AttributeEntity,
+		State::AttributeValue, State::AttributeEnd, State::Start, State::ElementStart, State::Bang,
+		State::CDataName, State::CDataValue, State::CDataEnd1, State::CDataValue, State::CDataEnd1,
+		State::CDataEnd2, State::CDataValue, State::CDataEnd1, State::CDataEnd2, State::Start,
+		State::Text, State::TextEntity, State::Text, State::ElementStart, State::ElementName,
+		State::EmptyElement, State::Start, State::ElementStart, State::ElementEnd, State::ElementEndName,
+		State::ElementEndSpace, State::Start,
+	};
+
+	GLib::Xml::StateEngine engine;
+	std::vector<State> actual;
+	for (char const chr : xml)
+	{
+		auto const oldState = engine.GetState();
+		if (auto const newState = engine.Push(chr); newState != oldState)
+		{
+			actual.push_back(newState);
+		}
+	}
+
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+}
+
+AUTO_TEST_CASE(StateEngineFlags)
+{
+	using GLib::Xml::State;
+
+	auto push = [](GLib::Xml::StateEngine & engine, std::string_view const value)
+	{
+		for (char const chr : value)
+		{
+			engine.Push(chr);
+		}
+		return engine.GetState();
+	};
+
+	GLib::Xml::StateEngine prolog;
+	TEST(push(prolog, " text") == State::Error);
+
+	GLib::Xml::StateEngine declaration;
+	TEST(push(declaration, " <?") == State::Error);
+
+	GLib::Xml::StateEngine docType;
+	TEST(push(docType, "<!DOCTYPE x><!D") == State::Error);
+
+	GLib::Xml::StateEngine quotes;
+	TEST(push(quotes, "<a b='\"") == State::AttributeValue);
+	TEST(push(quotes, "'") == State::AttributeEnd);
+	TEST(quotes.HasRootElement());
+
+	GLib::Xml::StateEngine content;
+	TEST(push(content, "<a/>text") == State::Text);
+}
+
 AUTO_TEST_CASE(EndOfTheWorld)
 {
 	Holder const xml("<xml/>");
@@ -419,11 +559,6 @@ AUTO_TEST_CASE(AttrNamespaceNotFound)
 
 AUTO_TEST_CASE(ElementTextEntities)
 {
-	/* TODO have iterator convert standard entities rather than just passing them on
-		CharRef: '&#' [0-9]+ ';' | '&#x' [0-9a-fA-F]+ ';'
-		EntityRef: '&' Name '; [amp, lt, gt, apos, quot]
-	*/
-
 	Holder xml {"<xml>&amp; &lt; &gt; &apos; &quot; &#x20ac; &#8364;</xml>"};
 
 	std::vector<Element> expected {
@@ -432,6 +567,11 @@ AUTO_TEST_CASE(ElementTextEntities)
 		{"xml", ElementType::Close, {}},
 	};
 	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
+
+	std::string buffer;
+	auto it = xml.begin();
+	++it;
+	TEST(it->DecodedText(buffer) == "& < > ' \" \xE2\x82\xAC \xE2\x82\xAC");
 }
 
 AUTO_TEST_CASE(AttributeEntities)
@@ -440,6 +580,45 @@ AUTO_TEST_CASE(AttributeEntities)
 
 	std::vector<Element> expected {{"xml", ElementType::Empty, Attributes {"attr='&lt;'"}}};
 	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), xml.begin(), xml.end());
+
+	std::string buffer;
+	auto const attribute = *xml.begin()->GetAttributes().begin();
+	TEST(attribute.Value == "&lt;");
+	TEST(attribute.DecodedValue(buffer) == "<");
+}
+
+AUTO_TEST_CASE(DecodeEntities)
+{
+	using GLib::Xml::Utils::Decode;
+
+	std::string buffer;
+	std::string_view const clean = "no entities here, just a long enough run to cover the vector blocks";
+	TEST(Decode(clean, buffer).data() == clean.data());
+	TEST(buffer.empty());
+
+	TEST(Decode("a&amp;b&#65;&#x42;", buffer) == "a&bAB");
+	TEST(Decode("&#x7f;&#x80;&#x7FF;&#x800;&#xFFFF;&#x10000;&#x10FFFF;", buffer) ==
+			 "\x7F\xC2\x80\xDF\xBF\xE0\xA0\x80\xEF\xBF\xBF\xF0\x90\x80\x80\xF4\x8F\xBF\xBF");
+	TEST(Decode("&custom; &amp;", buffer) == "&custom; &");
+
+	std::array<char, 16> arena {};
+	auto const decoded = Decode("1 &lt; 2", arena.data());
+	TEST(decoded == "1 < 2");
+	TEST(decoded.data() == arena.data());
+}
+
+AUTO_TEST_CASE(DecodeErrors)
+{
+	using GLib::Xml::Utils::Decode;
+
+	std::string buffer;
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&amp", buffer)); }, "Unterminated entity: &amp");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#;", buffer)); }, "Invalid character reference: &#;");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#x110000;", buffer)); }, "Invalid character reference: &#x110000;");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#xD800;", buffer)); }, "Invalid character reference: &#xD800;");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#12a;", buffer)); }, "Invalid character reference: &#12a;");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#0;", buffer)); }, "Invalid character reference: &#0;");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Decode("&#X43;", buffer)); }, "Invalid character reference: &#X43;");
 }
 
 AUTO_TEST_CASE(AttributeEntity)
@@ -493,6 +672,391 @@ AUTO_TEST_CASE(AttributeIteratorEnd)
 	GLIB_CHECK_RUNTIME_EXCEPTION(++Attributes {}.begin();, "++end");
 }
 
+AUTO_TEST_CASE(ScannerSkip)
+{
+	using GLib::Xml::Scanner::Delimiters;
+
+	std::string value(100, 'x');
+	value[17] = '\n';
+	value[40] = '\n';
+	value[70] = '<';
+
+	auto const * const begin = value.data();
+	auto const * const end = begin + value.size();
+
+	auto const run = GLib::Xml::Scanner::Skip(begin, end, Delimiters<2> {'<', '&'});
+	TEST(run.end - begin == 70);
+	TEST(run.newLines == 2U);
+	TEST(run.lastNewLine - begin == 40);
+
+	for (size_t start = 0; start < value.size(); ++start)
+	{
+		auto const simd = GLib::Xml::Scanner::Skip(begin + start, end, Delimiters<1> {'<'});
+		auto const scalar = GLib::Xml::Scanner::SkipScalar(begin + start, end, Delimiters<1> {'<'});
+		TEST((simd.end == scalar.end && simd.newLines == scalar.newLines && simd.lastNewLine == scalar.lastNewLine));
+		TEST(GLib::Xml::Scanner::Find(begin + start, end, Delimiters<1> {'<'}) == scalar.end);
+	}
+
+	auto const none = GLib::Xml::Scanner::Skip(begin + 71, end, Delimiters<1> {'<'});
+	TEST((none.end == end && none.newLines == 0U && none.lastNewLine == nullptr));
+}
+
+AUTO_TEST_CASE(ErrorPositionAfterLongRuns)
+{
+	std::string const text(40, 't');
+	std::string const xml = "<x a='" + text + "'>\n" + text + "\n" + text + "<!--" + text + "\n" + text + "-->" + "<![CDATA[" + text + "]]></x !";
+
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Parse(xml); }, "Illegal character: '!' (0x21) at line: 3, offset: 99");
+}
+
+AUTO_TEST_CASE(EmptyElementUsesOwnNameSpaces)
+{
+	Holder xml {R"(<foo:x xmlns:foo='foo-ns'><foo:y xmlns:foo='new-ns' xmlns:bar='bar-ns' bar:at='b'/><foo:z/></foo:x>)"};
+
+	std::vector<Attribute> attributes;
+	std::vector<std::string_view> nameSpaces;
+	for (auto const & e : xml)
+	{
+		nameSpaces.push_back(e.NameSpace());
+		for (auto const & a : e.GetAttributes())
+		{
+			attributes.push_back(a);
+		}
+	}
+
+	std::vector<std::string_view> const expectedNameSpaces {"foo-ns", "new-ns", "foo-ns", "foo-ns"};
+	CHECK_EQUAL_COLLECTIONS(expectedNameSpaces.begin(), expectedNameSpaces.end(), nameSpaces.begin(), nameSpaces.end());
+	std::vector<Attribute> const expected {{"at", "b", "bar-ns", "bar:at='b'"}};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), attributes.begin(), attributes.end());
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Parse("<x><y xmlns:bar='bar-ns'/><bar:z/></x>"); }, "NameSpace bar not found");
+}
+
+AUTO_TEST_CASE(StreamMatchesHolder)
+{
+	std::string const xml = R"(<?xml version='1.0'?>
+<!-- comment -->
+<foo:x xmlns:foo='foo-ns' a='1'>
+	<foo:y xmlns:foo='new-ns' xmlns:bar='bar-ns' bar:at='b'>text &amp; more</foo:y>
+	<![CDATA[ <cdata> ]]>
+	<z b="2"/>
+</foo:x>
+)";
+
+	for (size_t const chunkSize : {1, 2, 3, 7, 64, 4096})
+	{
+		std::istringstream stream {xml};
+		StreamHolder streamed {stream, chunkSize};
+		Holder held {xml};
+		CHECK_EQUAL_COLLECTIONS(held.begin(), held.end(), streamed.begin(), streamed.end());
+	}
+}
+
+AUTO_TEST_CASE(StreamViewsValidUntilIncrement)
+{
+	std::string const xml = "<x xmlns:n='ns'><n:y n:a='1' b='2'>some text</n:y></x>";
+
+	std::vector<std::string> values;
+	std::istringstream stream {xml};
+	StreamHolder streamed {stream, 1};
+	for (auto const & e : streamed)
+	{
+		values.emplace_back(std::string(e.QName()) + "|" + std::string(e.NameSpace()) + "|" + std::string(e.OuterXml()) + "|" + std::string(e.Text()));
+		for (auto const & a : e.GetAttributes())
+		{
+			values.emplace_back(std::string(a.Name) + "|" + std::string(a.NameSpace) + "|" + std::string(a.Value));
+		}
+	}
+
+	std::vector<std::string> const expected {
+		"x||<x xmlns:n='ns'>|", "n:y|ns|<n:y n:a='1' b='2'>|", "a|ns|1", "b||2", "|||some text", "n:y|ns|</n:y>|", "x||</x>|"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), values.begin(), values.end());
+}
+
+AUTO_TEST_CASE(StreamBufferDependsOnLargestElement)
+{
+	constexpr size_t chunkSize = 256;
+	constexpr size_t records = 10000;
+	std::string const record = "<record id='12345'>" + std::string(100, 'x') + "</record>\n";
+
+	std::string pending = "<records>";
+	size_t written {};
+	StreamHolder streamed {[&](char * const buffer, size_t const size)
+												 {
+													 if (pending.empty() && written <= records)
+													 {
+														 pending = written++ < records ? record : "</records>";
+													 }
+													 size_t const count = std::min(size, pending.size());
+													 std::copy_n(pending.begin(), count, buffer);
+													 pending.erase(0, count);
+													 return count;
+												 },
+												 chunkSize};
+
+	size_t count {};
+	for (auto const & e : streamed)
+	{
+		count += e.Type() == ElementType::Open && e.Name() == "record" ? 1 : 0;
+	}
+
+	CHECK(count == records);
+	CHECK(streamed.BufferSize() <= 2 * chunkSize);
+}
+
+AUTO_TEST_CASE(StreamErrors)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION({ ParseStream("<x><y></x>", 2); }, "Element mismatch: x != y, at byte: 10");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ ParseStream("<x><y/>", 2); }, "Xml not closed");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ ParseStream("", 2); }, "No root element");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ ParseStream("<x/><!-- x -->\n<y/>", 3); }, "Extra content at document end");
+}
+
+AUTO_TEST_CASE(SubtreesSplit)
+{
+	std::string const xml = R"(<?xml version='1.0'?>
+<!-- start -->
+<r:root xmlns:r='root-ns' a='>'>
+	<a x='/>' y="'>"><b/><!-- </a> --><![CDATA[</a>]]></a>
+	text<?pi </a> ?>
+	<c/>
+	<r:d><d><d/></d></r:d >
+</r:root >
+<!-- end -->
+)";
+
+	Subtrees const subtrees {xml};
+	TEST(subtrees.RootName() == "r:root");
+	std::vector<std::string_view> const expected {R"(<a x='/>' y="'>"><b/><!-- </a> --><![CDATA[</a>]]></a>)", "<c/>", "<r:d><d><d/></d></r:d >"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), subtrees.Children().begin(), subtrees.Children().end());
+
+	auto const names = ParseSubtrees(subtrees,
+																	 [](Holder & holder)
+																	 {
+																		 std::string value;
+																		 for (auto const & e : holder)
+																		 {
+																			 value += std::string(e.NameSpace()) + ':' + std::string(e.Name()) + ' ';
+																		 }
+																		 return value;
+																	 },
+																	 2);
+	std::vector<std::string> const expectedNames {":a :b : :a ", ":c ", "root-ns:d :d :d :d root-ns:d "};
+	CHECK_EQUAL_COLLECTIONS(expectedNames.begin(), expectedNames.end(), names.begin(), names.end());
+}
+
+AUTO_TEST_CASE(SubtreesMatchSequential)
+{
+	std::string xml = "<feed xmlns:x='urn:x'>";
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		xml += "<x:item id='" + std::to_string(i) + "'><title>" + std::to_string(i) + " &amp;</title><empty x:at='1'/></x:item>\n";
+	}
+	xml += "</feed>";
+
+	std::vector<std::string> sequential;
+	for (auto const & e : Holder {xml})
+	{
+		if (e.Depth() > 1 || e.Type() == ElementType::Text)
+		{
+			sequential.emplace_back(std::string(e.NameSpace()) + ':' + std::string(e.Name()) + std::string(e.Text()));
+		}
+	}
+
+	std::mutex lock;
+	size_t visited {};
+	Subtrees const subtrees {xml};
+	ForEachSubtree(subtrees,
+								 [&](size_t const index, Holder & holder)
+								 {
+									 static_cast<void>(index);
+									 size_t count {};
+									 for (auto const & e : holder)
+									 {
+										 static_cast<void>(e);
+										 ++count;
+									 }
+									 std::lock_guard const guard {lock};
+									 visited += count;
+								 },
+								 4);
+
+	auto const parallel = ParseSubtrees(subtrees,
+																			[](Holder & holder)
+																			{
+																				std::vector<std::string> values;
+																				for (auto const & e : holder)
+																				{
+																					values.emplace_back(std::string(e.NameSpace()) + ':' + std::string(e.Name()) + std::string(e.Text()));
+																				}
+																				return values;
+																			});
+
+	std::vector<std::string> flattened;
+	for (auto const & values : parallel)
+	{
+		flattened.insert(flattened.end(), values.begin(), values.end());
+	}
+	CHECK_EQUAL_COLLECTIONS(sequential.begin(), sequential.end(), flattened.begin(), flattened.end());
+	TEST(visited == sequential.size());
+}
+
+AUTO_TEST_CASE(SubtreesErrors)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Subtrees const s {"<root><a></a>"}; }, "Xml not closed");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Subtrees const s {"<root><a></a></rot>"}; }, "Element mismatch: rot != root");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Subtrees const s {"<root/><extra/>"}; }, "Extra content at document end");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Subtrees const s {"<root><a x='1></a></root>"}; }, "Xml not closed");
+
+	Subtrees const subtrees {"<root><a/><b></c></root>"};
+	auto const parse = [](size_t /*index*/, Holder & holder)
+	{
+		for (auto const & e : holder)
+		{
+			static_cast<void>(e);
+		}
+	};
+	GLIB_CHECK_RUNTIME_EXCEPTION(ForEachSubtree(subtrees, parse), "Element mismatch: c != b, at line: 0, offset: 7");
+}
+
+AUTO_TEST_CASE(AttributeIndexLookup)
+{
+	Holder xml {R"(<root xmlns='urn:d' xmlns:x='urn:x' a='1' x:a='2' b="&amp;"><sub c='3'/></root>)"};
+	auto it = xml.begin();
+
+	auto const & index = it->IndexedAttributes();
+	TEST(index.Size() == 5U);
+	TEST(index.Find("xmlns")->Declaration);
+	TEST(index.Find("xmlns:x")->Value == "urn:x");
+	TEST(index.Find("x:a")->Value == "2");
+	TEST(index.Find("a", "urn:x")->QName == "x:a");
+	TEST(index.Find("a", "")->Value == "1");
+	TEST(index.Find("x", "") == nullptr);
+	std::string buffer;
+	TEST(index.Find("b")->DecodedValue(buffer) == "&");
+	TEST(&it->IndexedAttributes() == &index);
+
+	auto copy = it;
+	++it;
+	TEST(it->IndexedAttributes().Find("c")->Value == "3");
+	TEST(copy->IndexedAttributes().Find("a")->Value == "1");
+
+	Element const kept = *copy;
+	++copy;
+	TEST(kept.IndexedAttributes().Find("a", "urn:x")->Value == "2");
+	TEST(&kept.IndexedAttributes() == &kept.IndexedAttributes());
+}
+
+AUTO_TEST_CASE(AttributeIndexOfCopies)
+{
+	Holder xml {"<a x='1'><b/><c y='2'/></a>"};
+	std::vector<Element> kept;
+	for (auto const & e : xml)
+	{
+		static_cast<void>(e.IndexedAttributes());
+		kept.push_back(e);
+	}
+
+	// not the iterator's, built again on first use
+	TEST(kept[0].IndexedAttributes().Find("x")->Value == "1");
+	TEST(kept[1].IndexedAttributes().Size() == 0U);
+	TEST(kept[2].IndexedAttributes().Find("y")->Value == "2");
+	TEST(kept[3].IndexedAttributes().Size() == 0U);
+
+	Element const copy = kept[2];
+	TEST(&copy.IndexedAttributes() != &kept[2].IndexedAttributes());
+	TEST(copy.IndexedAttributes().Find("y")->Value == "2");
+}
+
+AUTO_TEST_CASE(AttributeIndexOverflow)
+{
+	std::string xml = "<root";
+	for (char name = 'a'; name <= 'l'; ++name)
+	{
+		xml += ' ';
+		xml += name;
+		xml += "='";
+		xml += name;
+		xml += '\'';
+	}
+	xml += "/>";
+
+	Holder holder {xml};
+	auto const it = holder.begin();
+	auto const & index = it->IndexedAttributes();
+	TEST(index.Size() == 12U);
+	TEST(index.Find("a")->Value == "a");
+	TEST(index.Find("l")->Value == "l");
+	std::string joined;
+	for (auto const & attribute : index)
+	{
+		joined += attribute.Name;
+	}
+	TEST(joined == "abcdefghijkl");
+}
+
+namespace
+{
+	void AppendName(std::string & names, Element const & element)
+	{
+		if (element.Type() == ElementType::Open || element.Type() == ElementType::Empty || element.Type() == ElementType::Close)
+		{
+			names += element.Type() == ElementType::Close ? "/" : "";
+			names += element.QName();
+			names += ' ';
+		}
+	}
+
+	// the qualified names seen, skipping the subtree of elements named skip
+	std::string SkipSubtrees(GLib::Xml::Iterator it, GLib::Xml::Iterator const & end)
+	{
+		std::string names;
+		for (; it != end; ++it)
+		{
+			AppendName(names, *it);
+			if (it->Name() == "skip" && it->Type() == ElementType::Open)
+			{
+				it.SkipSubtree();
+				AppendName(names, *it);
+			}
+		}
+		return names;
+	}
+}
+
+AUTO_TEST_CASE(SkipSubtree)
+{
+	std::string_view constexpr xml = R"(<root xmlns:a='urn:a'>
+	<skip q='>' r="/>"><skip><x:in xmlns:x='urn:x'/></skip><!-- </skip> --><![CDATA[</skip>]]><?pi </skip>?>text</skip>
+	<skip/>
+	<a:after v='1'/>
+</root>)";
+
+	Holder holder {xml};
+	TEST(SkipSubtrees(holder.begin(), holder.end()) == "root skip /skip skip a:after /root ");
+
+	for (size_t const chunkSize : {1, 3, 7, 64})
+	{
+		std::istringstream stm {std::string {xml}};
+		StreamHolder streamed {stm, chunkSize};
+		TEST(SkipSubtrees(streamed.begin(), streamed.end()) == "root skip /skip skip a:after /root ");
+	}
+
+	Holder nameSpaces {"<r><skip xmlns:x='urn:x'><x:a/></skip><x:b/></r>"};
+	GLIB_CHECK_RUNTIME_EXCEPTION(SkipSubtrees(nameSpaces.begin(), nameSpaces.end()), "NameSpace x not found");
+}
+
+AUTO_TEST_CASE(SkipSubtreeErrors)
+{
+	Holder unclosed {"<r><skip><a></a>"};
+	GLIB_CHECK_RUNTIME_EXCEPTION(SkipSubtrees(unclosed.begin(), unclosed.end()), "Xml not closed");
+
+	Holder unbalanced {"<r><skip><a></skip>\n</r>"};
+	GLIB_CHECK_RUNTIME_EXCEPTION(SkipSubtrees(unbalanced.begin(), unbalanced.end()), "Element mismatch: r != skip, at line: 1, offset: 4");
+
+	Holder comment {"<r><skip><!-- --</skip></r>"};
+	GLIB_CHECK_RUNTIME_EXCEPTION(SkipSubtrees(comment.begin(), comment.end()), "Xml not closed");
+}
+
 // test comment, text, attributes with entities and combos
 
 AUTO_TEST_CASE(PrinterEscapes) // move, expand
@@ -502,6 +1066,31 @@ AUTO_TEST_CASE(PrinterEscapes) // move, expand
 	TEST("Start &amp;&amp; End" == p.Xml());
 }
 
+AUTO_TEST_CASE(EscapeSinglePass)
+{
+	using GLib::Xml::Utils::Escape;
+
+	std::string const padding(40, '.');
+	std::vector<std::pair<std::string, std::string>> const cases {
+		{"", ""},
+		{"plain", "plain"},
+		{"<a href=\"x\">'&'</a>", "&lt;a href=&quot;x&quot;&gt;&apos;&amp;&apos;&lt;/a&gt;"},
+		{padding + "&" + padding + "<>", padding + "&amp;" + padding + "&lt;&gt;"},
+		{"&&&&&&&&&&&&&&&&&&", "&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;&amp;"},
+	};
+
+	for (auto const & [value, expected] : cases)
+	{
+		std::string escaped;
+		Escape(value, escaped);
+		TEST(escaped == expected);
+
+		std::ostringstream stm;
+		Escape(value, stm);
+		TEST(stm.str() == expected);
+	}
+}
+
 AUTO_TEST_CASE(PrinterFormat)
 {
 	{
@@ -538,4 +1127,411 @@ AUTO_TEST_CASE(PrinterFormat)
 	}
 }
 
+AUTO_TEST_CASE(PrinterRelease)
+{
+	Printer p;
+	p.PushDeclaration();
+	p.OpenElement("Root");
+	p.PushAttribute("count", int64_t {-42});
+	p.OpenElement("Text");
+	p.PushText("a < b");
+	p.CloseElement();
+	p.OpenElement("Empty");
+	p.Close();
+	std::string_view constexpr expected = R"(<?xml version="1.0" encoding="UTF-8" ?>
+<Root count="-42">
+ <Text>a &lt; b</Text>
+ <Empty/>
+</Root>
+)";
+	TEST(p.Xml() == expected);
+	TEST(p.Release() == expected);
+	TEST(p.Xml().empty());
+}
+
+AUTO_TEST_CASE(PrinterSink)
+{
+	std::vector<std::string> pieces;
+	auto sink = [&](std::string_view const value) { pieces.emplace_back(value); };
+	GLib::Xml::BasicPrinter<decltype(sink)> p {sink, false};
+	p.OpenElement("a");
+	p.PushText("&");
+	p.CloseElement();
+	std::vector<std::string> const expected {"<", "a", ">", "&amp;", "</", "a", ">"};
+	CHECK_EQUAL_COLLECTIONS(pieces.begin(), pieces.end(), expected.begin(), expected.end());
+}
+
+AUTO_TEST_CASE(PrinterDeepIndent)
+{
+	constexpr size_t depth = 100;
+	Printer p;
+	std::ostringstream expected;
+	for (size_t i = 0; i < depth; ++i)
+	{
+		std::ostringstream name;
+		name << 'e' << i;
+		p.OpenElement(name.str());
+		expected << (i == 0 ? "" : "\n") << std::string(i, ' ') << '<' << name.str() << (i == depth - 1 ? "/>" : ">");
+	}
+	for (size_t i = depth - 1; i-- > 0;)
+	{
+		expected << '\n' << std::string(i, ' ') << "</e" << i << '>';
+	}
+	expected << '\n';
+
+	GLIB_CHECK_RUNTIME_EXCEPTION(static_cast<void>(p.Xml()), "Element is not closed: e99");
+	p.Close();
+	TEST(p.Xml() == expected.str());
+}
+
+AUTO_TEST_CASE(Utf8Validate)
+{
+	using GLib::Xml::Utf8::IsValid;
+
+	for (std::string_view const valid : {"a", "\xC3\xA9", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEF\xBF\xBF", "\xF0\x9D\x84\x9E", "\xF4\x8F\xBF\xBF"})
+	{
+		TEST(IsValid(valid));
+	}
+
+	// overlong, surrogate, above U+10FFFF, stray continuation, truncated, never valid
+	for (std::string_view const invalid : {"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xF0\x8F\xBF\xBF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\x80", "\xC3",
+																				 "\xE2\x82", "\xF5\x80\x80\x80", "\xFF"})
+	{
+		TEST(!IsValid(invalid));
+	}
+
+	// the vector path over ASCII blocks stops at the bad byte
+	std::string value(100, 'x');
+	value[70] = '\xFE';
+	auto const result = GLib::Xml::Utf8::Validate(value.data(), value.data() + value.size());
+	TEST(result.end - value.data() == 70);
+	TEST((result.state == GLib::Xml::Utf8::State::Reject));
+}
+
+AUTO_TEST_CASE(Utf8Iterate)
+{
+	using GLib::Xml::Utf8::Validation;
+
+	std::string const xml = "<r\xC3\xA9 a='\xE2\x82\xAC'>\n\t<!-- \xF0\x9D\x84\x9E -->" + std::string(40, 'x') + "\xC3\xA9<![CDATA[\xEF\xBF\xBF]]></r\xC3\xA9>";
+
+	Holder unchecked {xml};
+	Holder checked {xml, Validation::On};
+	CHECK_EQUAL_COLLECTIONS(unchecked.begin(), unchecked.end(), checked.begin(), checked.end());
+
+	// sequences split between refills
+	for (size_t const chunkSize : {1, 2, 3, 5})
+	{
+		std::istringstream stream {xml};
+		StreamHolder streamed {Validation::On, stream, chunkSize};
+		CHECK_EQUAL_COLLECTIONS(unchecked.begin(), unchecked.end(), streamed.begin(), streamed.end());
+	}
+}
+
+AUTO_TEST_CASE(Utf8Errors)
+{
+	using GLib::Xml::Utf8::Validation;
+
+	auto const parse = [](std::string_view const xml)
+	{
+		for (auto const & e : Holder {xml, Validation::On})
+		{
+			static_cast<void>(e);
+		}
+	};
+
+	GLIB_CHECK_RUNTIME_EXCEPTION({ parse("<a\xFF/>"); }, "Invalid UTF-8 byte (0xff) at line: 0, offset: 2");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ parse("<a b='\xED\xA0\x80'/>"); }, "Invalid UTF-8 byte (0xa0) at line: 0, offset: 7");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ parse("<a>\nxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx\n   \xC3(</a>"); }, "Invalid UTF-8 byte (0x28) at line: 2, offset: 4");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ parse("<a><!-- \xE0\x80\x80 --></a>"); }, "Invalid UTF-8 byte (0x80) at line: 0, offset: 9");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ parse("<a/>\n\xE2\x82"); }, "Incomplete UTF-8 sequence at line: 1, offset: 2");
+
+	Holder skipped {"<r><s>\n \xFF</s></r>", Validation::On};
+	GLIB_CHECK_RUNTIME_EXCEPTION({ skipped.begin().SkipSubtree(); }, "Invalid UTF-8 byte (0xff) at line: 1, offset: 1");
+
+	std::istringstream stream {"<a>\xC3\xA9\xA9</a>"};
+	StreamHolder streamed {Validation::On, stream, 2};
+	GLIB_CHECK_RUNTIME_EXCEPTION(
+		{
+			for (auto const & e : streamed)
+			{
+				static_cast<void>(e);
+			}
+		},
+		"Invalid UTF-8 byte (0xa9) at byte: 5");
+
+	Parse("<a\xFF/>"); // unchecked by default
+}
+
+AUTO_TEST_CASE(ElementPositions)
+{
+	std::string const xml = "<a>\n  <b x='1'/>\n\ttext\n<!-- c --></a>";
+
+	auto const positions = [](auto && elements)
+	{
+		std::vector<std::string> values;
+		for (auto it = elements.begin(), end = elements.end(); it != end; ++it)
+		{
+			auto const position = it.GetPosition();
+			std::ostringstream stm;
+			stm << position.Line << ':' << position.Column << '@' << position.Offset;
+			TEST(it->Offset() == position.Offset);
+			values.push_back(stm.str());
+		}
+		return values;
+	};
+
+	std::vector<std::string> const expected {"0:0@0", "1:2@6", "1:12@16", "3:0@23", "3:10@33"};
+	auto const held = positions(Holder {xml});
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), held.begin(), held.end());
+
+	// copies kept after the iteration work theirs out from the input
+	std::vector<Element> elements;
+	for (auto e : Holder {xml})
+	{
+		elements.push_back(e);
+	}
+	std::vector<std::string> copied(elements.size());
+	for (size_t index = elements.size(); index-- != 0;)
+	{
+		auto const position = elements[index].GetPosition();
+		std::ostringstream stm;
+		stm << position.Line << ':' << position.Column << '@' << position.Offset;
+		copied[index] = stm.str();
+	}
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), copied.begin(), copied.end());
+
+	for (size_t const chunkSize : {1, 2, 3, 7})
+	{
+		std::istringstream stream {xml};
+		auto const streamed = positions(StreamHolder {stream, chunkSize});
+		CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), streamed.begin(), streamed.end());
+	}
+}
+
+AUTO_TEST_CASE(ElementPositionErrors)
+{
+	std::istringstream stream {"<a><b/><c/></a>"};
+	StreamHolder streamed {stream, 1};
+	auto it = streamed.begin();
+	auto const first = it->Offset();
+	++it;
+	++it;
+	GLIB_CHECK_LOGIC_EXCEPTION({ static_cast<void>(it.GetPosition(first)); }, "Position no longer buffered");
+	GLIB_CHECK_LOGIC_EXCEPTION({ static_cast<void>(it->GetPosition()); }, "No position for an element of streamed input, see Iterator::GetPosition");
+	TEST(!it.GetPosition().Counted); // dropped before a position was asked for
+	TEST(it.GetPosition().Offset == 7U);
+	TEST(it.GetPosition(it->Offset()).Offset == 7U);
+
+	std::istringstream tracked {"<x>\n<y>\n</x>"};
+	StreamHolder tracking {tracked, 2};
+	auto tracker = tracking.begin();
+	TEST(tracker.GetPosition().Counted); // counts the dropped input from here on
+	GLIB_CHECK_RUNTIME_EXCEPTION(
+		{
+			for (; tracker != tracking.end(); ++tracker)
+			{
+			}
+		},
+		"Element mismatch: x != y, at line: 2, offset: 4");
+}
+
+AUTO_TEST_CASE(NameSpaceValueEntities)
+{
+	std::string const xml = "<x:a xmlns:x='urn:&amp;x' xmlns='a&lt;b'><b/></x:a>";
+
+	Holder held {xml}; // decoded values live in its manager
+	std::vector<std::string_view> nameSpaces;
+	for (auto const & e : held)
+	{
+		nameSpaces.push_back(e.NameSpace());
+	}
+	std::vector<std::string_view> const expected {"urn:&x", "a<b", "urn:&x"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), nameSpaces.begin(), nameSpaces.end());
+
+	std::istringstream stream {xml};
+	std::vector<std::string> streamed;
+	for (auto const & e : StreamHolder {stream, 3})
+	{
+		streamed.emplace_back(e.NameSpace());
+	}
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), streamed.begin(), streamed.end());
+}
+
+AUTO_TEST_CASE(DecodedNameSpacesGoOutOfScope)
+{
+	class PeakResource : public std::pmr::memory_resource
+	{
+		size_t live {};
+
+	public:
+		size_t peak {};
+
+	private:
+		void * do_allocate(size_t const bytes, size_t const alignment) override
+		{
+			peak = std::max(peak, live += bytes);
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void * const ptr, size_t const bytes, size_t const alignment) override
+		{
+			live -= bytes;
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+		}
+
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	auto const peak = [](size_t const records)
+	{
+		std::string xml = "<r>";
+		for (size_t i = 0; i < records; ++i)
+		{
+			xml += "<x:e xmlns:x='urn:a-long-enough-namespace&amp;" + std::to_string(i % 10) + "'><x:f/></x:e>";
+		}
+		xml += "</r>";
+
+		PeakResource resource;
+		size_t count {};
+		for (auto const & e : Holder {xml, &resource})
+		{
+			count += e.NameSpace().starts_with("urn:a-long-enough-namespace&") ? 1 : 0;
+		}
+		TEST(count == 3 * records);
+		return resource.peak;
+	};
+	TEST(peak(10) == peak(1000));
+}
+
+AUTO_TEST_CASE(NameSpaceValueAfterEntity)
+{
+	std::string const xml = R"(<a xmlns='&lt;x' xmlns:b="x&amp;y&amp;z" xmlns:c='x&gt;'><b:e/><c:e/></a>)";
+	std::vector<std::string> const expected {"<x", "x&y&z", "x>"};
+
+	std::vector<std::string> held;
+	for (auto const & e : Holder {xml})
+	{
+		if (e.Type() != ElementType::Close)
+		{
+			held.emplace_back(e.NameSpace());
+		}
+	}
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), held.begin(), held.end());
+
+	for (size_t const chunkSize : {1, 4})
+	{
+		std::istringstream stream {xml};
+		std::vector<std::string> streamed;
+		for (auto const & e : StreamHolder {stream, chunkSize})
+		{
+			if (e.Type() != ElementType::Close)
+			{
+				streamed.emplace_back(e.NameSpace());
+			}
+		}
+		CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), streamed.begin(), streamed.end());
+	}
+}
+
+AUTO_TEST_CASE(CloseWithNothingOpen)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Parse("</a>"); }, "Element not open: a, at line: 0, offset: 4");
+	GLIB_CHECK_RUNTIME_EXCEPTION({ Parse("<!-- c -->\n</a><a/>"); }, "Element not open: a, at line: 1, offset: 4");
+	for (size_t const chunkSize : {1, 2, 5})
+	{
+		GLIB_CHECK_RUNTIME_EXCEPTION({ ParseStream("</a>", chunkSize); }, "Element not open: a, at line: 0, offset: 4");
+	}
+}
+
+AUTO_TEST_CASE(ArenaResource)
+{
+	std::string xml = "<r";
+	for (char prefix = 'a'; prefix <= 'l'; ++prefix)
+	{
+		xml += std::string(" xmlns:") + prefix + "='urn:" + prefix + "&amp;'";
+	}
+	xml += ">";
+	for (int depth = 0; depth < 40; ++depth)
+	{
+		xml += "<l:n a='1' b='2' c='3' d='4' e='5' f='6' g='7' h='8' i='9'>";
+	}
+	for (int depth = 0; depth < 40; ++depth)
+	{
+		xml += "</l:n>";
+	}
+	xml += "</r>";
+
+	std::vector<std::string> expected;
+	for (auto const & e : Holder {xml})
+	{
+		expected.emplace_back(std::string(e.NameSpace()) + std::to_string(e.IndexedAttributes().Size()));
+	}
+
+	// anything not from the arena fails, an arena whose upstream is the null resource
+	std::array<std::byte, 16 * 1024> buffer {};
+	std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	std::pmr::memory_resource * const defaultResource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+	std::vector<std::string> values;
+	values.reserve(2 * expected.size());
+	for (int message = 0; message < 2; ++message)
+	{
+		for (auto const & e : Holder {xml, &arena})
+		{
+			values.emplace_back(std::string(e.NameSpace()) + std::to_string(e.IndexedAttributes().Size()));
+		}
+		arena.release();
+	}
+	std::pmr::set_default_resource(defaultResource);
+
+	std::vector<std::string> twice {expected};
+	twice.insert(twice.end(), expected.begin(), expected.end());
+	CHECK_EQUAL_COLLECTIONS(twice.begin(), twice.end(), values.begin(), values.end());
+}
+
+AUTO_TEST_CASE(ArenaResourceDecodedNameSpace)
+{
+	// longer than any small string buffer
+	std::string const nameSpace = "urn:" + std::string(100, 'n') + "&";
+	std::string const xml = "<p:r xmlns:p='urn:" + std::string(100, 'n') + "&amp;'><p:c/></p:r>";
+
+	std::array<std::byte, 4 * 1024> buffer {};
+	std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	std::pmr::memory_resource * const defaultResource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+	uint64_t const before = Allocations::Count();
+	size_t matched {};
+	for (auto const & e : Holder {xml, &arena})
+	{
+		matched += e.NameSpace() == nameSpace ? 1U : 0U;
+	}
+	uint64_t const allocations = Allocations::Count() - before;
+	std::pmr::set_default_resource(defaultResource);
+
+	TEST(matched == 3U);
+	TEST(allocations == 0U);
+}
+
+AUTO_TEST_CASE(ArenaResourceIteratorCopy)
+{
+	std::string xml = "<r";
+	for (char name = 'a'; name <= 'l'; ++name)
+	{
+		xml += std::string(" ") + name + "='" + name + '\'';
+	}
+	xml += "/>";
+
+	std::array<std::byte, 4 * 1024> buffer {};
+	std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+	std::pmr::memory_resource * const defaultResource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+	Holder holder {xml, &arena};
+	auto const it = holder.begin();
+	auto const copy = it; // NOLINT(performance-unnecessary-copy-initialization)
+	size_t const size = copy->IndexedAttributes().Size();
+	std::pmr::set_default_resource(defaultResource);
+
+	TEST(size == 12U);
+}
+
 AUTO_TEST_SUITE_END()
\ No newline at end of file
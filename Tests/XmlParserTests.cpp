@@ -0,0 +1,128 @@
+#include <GLib/Xml/Parser.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+using GLib::Xml::ElementType;
+using GLib::Xml::Holder;
+using GLib::Xml::ParseBatch;
+using GLib::Xml::Parser;
+
+namespace
+{
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t allocations {};
+
+	private:
+		void * do_allocate(size_t const bytes, size_t const alignment) override
+		{
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void * const ptr, size_t const bytes, size_t const alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+		}
+
+		[[nodiscard]] bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	std::string Names(Holder holder)
+	{
+		std::string value;
+		for (auto const & e : holder)
+		{
+			if (e.Type() != ElementType::Close)
+			{
+				value += e.QName();
+				value += e.NameSpace();
+			}
+		}
+		return value;
+	}
+}
+
+AUTO_TEST_SUITE(XmlParserTests)
+
+AUTO_TEST_CASE(ReuseKeepsCapacity)
+{
+	std::string_view constexpr xml = "<x:a xmlns:x='urn:&amp;x' xmlns:y='y'><x:b><y:c><d/></y:c></x:b></x:a>";
+
+	CountingResource upstream;
+	Parser parser {&upstream};
+	TEST(Names(parser.Parse(xml)) == "x:aurn:&xx:burn:&xy:cyd");
+	size_t const warmedUp = upstream.allocations;
+	TEST(warmedUp != 0U);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		TEST(Names(parser.Parse(xml)) == "x:aurn:&xx:burn:&xy:cyd");
+	}
+	TEST(upstream.allocations == warmedUp);
+
+	parser.Release();
+	TEST(Names(parser.Parse("<a/>")) == "a");
+}
+
+AUTO_TEST_CASE(ParseErrorDoesNotSpoilTheNext)
+{
+	Parser parser;
+	GLIB_CHECK_RUNTIME_EXCEPTION({ static_cast<void>(Names(parser.Parse("<a><b></a>"))); }, "Element mismatch: a != b, at line: 0, offset: 10");
+	TEST(Names(parser.Parse("<a><b/></a>")) == "ab");
+}
+
+AUTO_TEST_CASE(Batch)
+{
+	std::vector<std::string> documents;
+	for (int i = 0; i < 500; ++i)
+	{
+		documents.push_back(i % 7 == 3 ? "<a><b></a>" : "<a n='" + std::to_string(i) + "'/>");
+	}
+	std::vector<std::string_view> const views {documents.begin(), documents.end()};
+
+	auto const attribute = [](Holder & holder)
+	{
+		std::string value;
+		for (auto const & e : holder)
+		{
+			for (auto const & a : e.GetAttributes())
+			{
+				value = a.Value;
+			}
+		}
+		return value;
+	};
+
+	for (size_t const threads : {0, 1, 4})
+	{
+		auto const results = ParseBatch(views, attribute, threads);
+		TEST(results.size() == documents.size());
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			if (i % 7 == 3)
+			{
+				TEST(!results[i].Ok());
+				TEST(results[i].Error == "Element mismatch: a != b, at line: 0, offset: 10");
+			}
+			else
+			{
+				TEST(results[i].Ok());
+				TEST(*results[i].Value == std::to_string(i));
+			}
+		}
+	}
+
+	auto const defaulted = ParseBatch(views, attribute); // hardware concurrency
+	TEST(defaulted.size() == documents.size());
+	TEST(*defaulted.back().Value == std::to_string(documents.size() - 1));
+	TEST(ParseBatch({}, attribute).empty());
+}
+
+AUTO_TEST_SUITE_END()
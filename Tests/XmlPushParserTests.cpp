@@ -0,0 +1,229 @@
+#include <GLib/Xml/PushParser.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+using GLib::Xml::Element;
+using GLib::Xml::ElementType;
+using GLib::Xml::Holder;
+using GLib::Xml::PushParser;
+
+namespace
+{
+	std::string Describe(Element const & e)
+	{
+		std::string value;
+		value += std::to_string(static_cast<int>(e.Type()));
+		value += '|';
+		value += e.QName();
+		value += '|';
+		value += e.NameSpace();
+		value += '|';
+		value += e.Text();
+		for (auto const & a : e.GetAttributes())
+		{
+			value += '|';
+			value += a.Name;
+			value += '=';
+			value += a.NameSpace;
+			value += ':';
+			value += a.Value;
+		}
+		return value;
+	}
+
+	// feeds copies of each fragment that die after the batch, so nothing may refer to them later
+	// text cut by a fragment comes in pieces, they are joined to compare with a whole document parse
+	std::vector<std::string> PushInFragments(std::string_view const xml, size_t const fragmentSize)
+	{
+		std::vector<std::string> values;
+		PushParser parser;
+		bool lastText {};
+		for (size_t offset = 0; offset < xml.size(); offset += fragmentSize)
+		{
+			std::string const fragment {xml.substr(offset, fragmentSize)};
+			for (auto const & e : parser.Feed(fragment))
+			{
+				bool const text = e.Type() == ElementType::Text;
+				if (text && lastText)
+				{
+					values.back() += e.Text();
+				}
+				else
+				{
+					values.push_back(Describe(e));
+				}
+				lastText = text;
+			}
+		}
+		parser.Finish();
+		return values;
+	}
+}
+
+AUTO_TEST_SUITE(XmlPushParserTests)
+
+AUTO_TEST_CASE(MatchesHolderAtEverySplit)
+{
+	std::string_view constexpr xml = R"(<?xml version='1.0'?>
+<!-- comment -->
+<foo:x xmlns:foo='foo-ns' a='1'>
+	<foo:y xmlns:foo='new-ns' xmlns:bar='bar-ns' bar:at='b>c'>text &amp; more</foo:y>
+	<![CDATA[ <cdata> ]]>
+	<z b="2"/>
+</foo:x>
+)";
+
+	std::vector<std::string> expected;
+	for (auto const & e : Holder {xml})
+	{
+		expected.push_back(Describe(e));
+	}
+
+	for (size_t fragmentSize = 1; fragmentSize <= xml.size(); ++fragmentSize)
+	{
+		auto const values = PushInFragments(xml, fragmentSize);
+		CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), values.begin(), values.end());
+	}
+}
+
+AUTO_TEST_CASE(ElementsCompleteWithTheirLastByte)
+{
+	PushParser parser;
+	std::vector<std::string> values;
+	for (std::string_view const fragment : {"<root><a x='", "1'/", "><b>te", "xt</", "b>"})
+	{
+		size_t count {};
+		for (auto const & e : parser.Feed(fragment))
+		{
+			values.push_back(Describe(e));
+			++count;
+		}
+		values.push_back(std::to_string(count));
+	}
+	for (auto const & e : parser.Feed("</root>"))
+	{
+		values.push_back(Describe(e));
+	}
+	parser.Finish();
+
+	std::vector<std::string> const expected {"0|root||", "1", "0", "1|a|||x=:1", "0|b||", "3|||te", "3", "3|||xt", "1", "2|b||", "1", "2|root||"};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), values.begin(), values.end());
+}
+
+AUTO_TEST_CASE(Positions)
+{
+	PushParser parser;
+	std::vector<size_t> columns;
+	for (std::string_view const fragment : {"<root>\n <a", "/><b/>", "</root>"})
+	{
+		auto batch = parser.Feed(fragment);
+		for (auto it = batch.begin(), end = batch.end(); it != end; ++it)
+		{
+			columns.push_back(it.GetPosition().Line * 100 + it.GetPosition().Column);
+		}
+	}
+	std::vector<size_t> const expected {0, 101, 105, 109};
+	CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), columns.begin(), columns.end());
+}
+
+AUTO_TEST_CASE(CarryHoldsOnlyTheIncompleteElement)
+{
+	std::string xml = "<records>";
+	for (int i = 0; i < 1000; ++i)
+	{
+		xml += "<record id='12345'>";
+		xml += std::string(100, 'x');
+		xml += "</record>\n";
+	}
+	xml += "</records>";
+
+	constexpr size_t fragmentSize = 61;
+	PushParser parser;
+	size_t count {};
+	for (size_t offset = 0; offset < xml.size(); offset += fragmentSize)
+	{
+		for (auto const & e : parser.Feed(std::string_view {xml}.substr(offset, fragmentSize)))
+		{
+			count += e.Type() == ElementType::Open && e.Name() == "record" ? 1 : 0;
+		}
+	}
+	parser.Finish();
+
+	TEST(count == 1000U);
+	constexpr size_t largestElement = 19; // text is yielded as far as it goes, only tags are carried
+	TEST(parser.CarryCapacity() <= 2 * (largestElement + fragmentSize));
+}
+
+AUTO_TEST_CASE(LongTextIsNotCarried)
+{
+	std::string text;
+	for (int i = 0; i < 10000; ++i)
+	{
+		text += "caf\xC3\xA9 &amp; th\xE2\x82\xAC ";
+	}
+	std::string const xml = "<a>" + text + "</a>";
+
+	for (size_t const fragmentSize : {1, 2, 3, 61, 4096})
+	{
+		PushParser parser;
+		std::string joined;
+		for (size_t offset = 0; offset < xml.size(); offset += fragmentSize)
+		{
+			for (auto const & e : parser.Feed(std::string_view {xml}.substr(offset, fragmentSize)))
+			{
+				if (e.Type() == ElementType::Text)
+				{
+					TEST(GLib::Xml::Utf8::IsValid(e.Text())); // no character cut in two
+					joined += e.Text();
+				}
+			}
+		}
+		parser.Finish();
+
+		TEST(joined == text);
+		TEST(parser.CarryCapacity() <= 128U);
+	}
+}
+
+AUTO_TEST_CASE(Errors)
+{
+	{
+		PushParser parser;
+		static_cast<void>(parser.Feed("<x><y/>"));
+		GLIB_CHECK_LOGIC_EXCEPTION({ static_cast<void>(parser.Feed("</x>")); }, "Elements of the previous feed not consumed");
+	}
+
+	{
+		PushParser parser;
+		for (auto const & e : parser.Feed("<x><y/>"))
+		{
+			static_cast<void>(e);
+		}
+		GLIB_CHECK_RUNTIME_EXCEPTION({ parser.Finish(); }, "Xml not closed");
+	}
+
+	{
+		PushParser parser;
+		GLIB_CHECK_RUNTIME_EXCEPTION({ parser.Finish(); }, "No root element");
+	}
+
+	{
+		PushParser parser;
+		for (auto const & e : parser.Feed("<x>"))
+		{
+			static_cast<void>(e);
+		}
+		GLIB_CHECK_RUNTIME_EXCEPTION(
+			{
+				for (auto const & e : parser.Feed("</y>"))
+				{
+					static_cast<void>(e);
+				}
+			},
+			"Element mismatch: y != x, at byte: 7");
+	}
+}
+
+AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+#include <GLib/Xml/Query.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "TestUtils.h"
+
+using GLib::Xml::Attribute;
+using GLib::Xml::Element;
+using GLib::Xml::Query;
+
+namespace
+{
+	std::string_view constexpr Feed = R"(<feed xmlns:x='urn:x'>
+	<item id='1' kind='a'><title>One</title><x:price currency='GBP'>1.99</x:price></item>
+	<item id='2' kind='b'><title>Two</title><x:price currency='USD'>2.99</x:price><price currency='EUR'/></item>
+	<group><item id='3' kind='a &amp; b'><title>Three</title></item></group>
+</feed>)";
+
+	Query::NameSpaces const NameSpaces {{"x", "urn:x"}};
+
+	// attribute values for attribute queries, otherwise the qualified names with the id attribute if there is one
+	std::vector<std::string> Select(std::string_view const path, std::string_view const xml = Feed)
+	{
+		std::vector<std::string> result;
+		Query const query {path, NameSpaces};
+		query.Run(xml,
+							[&](Element const & element, Attribute const * attribute)
+							{
+								if (attribute != nullptr)
+								{
+									result.emplace_back(attribute->Value);
+									return;
+								}
+								std::string value {element.QName()};
+								for (auto const & a : element.GetAttributes())
+								{
+									if (a.Name == "id")
+									{
+										value += '#';
+										value += a.Value;
+									}
+								}
+								result.push_back(value);
+							});
+		return result;
+	}
+
+	void CheckSelect(std::string_view const path, std::vector<std::string> const & expected)
+	{
+		auto const result = Select(path);
+		CHECK_EQUAL_COLLECTIONS(result.begin(), result.end(), expected.begin(), expected.end());
+	}
+}
+
+AUTO_TEST_SUITE(XmlQueryTests)
+
+AUTO_TEST_CASE(ChildSteps)
+{
+	CheckSelect("/feed", {"feed"});
+	CheckSelect("/feed/item", {"item#1", "item#2"});
+	CheckSelect("/feed/item/title", {"title", "title"});
+	CheckSelect("/item", {});
+	CheckSelect("/feed/*", {"item#1", "item#2", "group"});
+}
+
+AUTO_TEST_CASE(DescendantSteps)
+{
+	CheckSelect("//item", {"item#1", "item#2", "item#3"});
+	CheckSelect("/feed//title", {"title", "title", "title"});
+	CheckSelect("//group//title", {"title"});
+	CheckSelect("//feed//item//title", {"title", "title", "title"});
+
+	auto const nested = Select("//a//b", "<a><a><b/></a><b><b/></b></a>");
+	std::vector<std::string> const expected {"b", "b", "b"};
+	CHECK_EQUAL_COLLECTIONS(nested.begin(), nested.end(), expected.begin(), expected.end());
+}
+
+AUTO_TEST_CASE(NameSpaceTests)
+{
+	CheckSelect("/feed/item/x:price", {"x:price", "x:price"});
+	CheckSelect("/feed/item/price", {"price"});
+	CheckSelect("/feed/item/x:*", {"x:price", "x:price"});
+	CheckSelect("//*/@currency", {"GBP", "USD", "EUR"});
+}
+
+AUTO_TEST_CASE(AttributePredicates)
+{
+	CheckSelect("//item[@kind='a']", {"item#1"});
+	CheckSelect(R"(//item[@kind="a & b"])", {"item#3"});
+	CheckSelect("/feed/item[@id][@kind='b']/x:price", {"x:price"});
+	CheckSelect("//item[@missing]", {});
+}
+
+AUTO_TEST_CASE(AttributeSteps)
+{
+	CheckSelect("/feed/item/x:price/@currency", {"GBP", "USD"});
+	CheckSelect("//item/@id", {"1", "2", "3"});
+	CheckSelect("/feed/item[@id='2']/@*", {"2", "b"});
+}
+
+AUTO_TEST_CASE(SkippedSubtreesAreBalanced)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION(Select("/feed/item", "<feed><other><a></other></feed>"),
+															 "Element mismatch: feed != other, at line: 0, offset: 31");
+}
+
+AUTO_TEST_CASE(InvalidQueries)
+{
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"feed"}, "Invalid query: path must start with '/', at offset: 0");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"/feed/"}, "Invalid query: invalid name '', at offset: 6");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"/y:feed"}, "Invalid query: unknown prefix 'y', at offset: 7");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"/feed[@a='1'"}, "Invalid query: expected ']', at offset: 12");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"/feed/@a/b"}, "Invalid query: attribute step must be last, at offset: 8");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"//@a"}, "Invalid query: descendant attribute steps are not supported, at offset: 3");
+	GLIB_CHECK_RUNTIME_EXCEPTION(Query {"/@a"}, "Invalid query: no element steps, at offset: 3");
+}
+
+AUTO_TEST_SUITE_END()
@@ -2,6 +2,7 @@
 
 #include <GLib/Xml/AttributeIterator.h>
 #include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Stream.h>
 
 namespace GLib::Xml
 {
@@ -79,4 +80,16 @@ namespace GLib::Xml
 			}
 		}
 	}
+
+	inline void ParseStream(std::string const & xml, size_t const chunkSize)
+	{
+		std::istringstream stream {xml};
+		for (auto const & e : StreamHolder {stream, chunkSize})
+		{
+			for (auto const & a : e.GetAttributes())
+			{
+				static_cast<void>(a);
+			}
+		}
+	}
 }
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <GLib/Compat.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/*
+Buffered output, appends are copied into one contiguous buffer that is handed to the writer in blocks of the capacity
+appends larger than the buffer go to the writer directly after what is buffered
+numbers are formatted in place with to_chars, floating point as std::to_string formats it
+Flush before the target is used or closed, the destructor flushes but cannot report a failure
+*/
+
+namespace GLib::Util
+{
+	// called with each block of output
+	using Writer = std::function<void(std::string_view)>;
+
+	class Appender
+	{
+		static constexpr size_t DefaultCapacity = 64 * 1024;
+
+		Writer writer;
+		size_t const capacity;
+		std::unique_ptr<char[]> const buffer;
+		size_t size {};
+
+	public:
+		explicit Appender(Writer writer, size_t const capacity = DefaultCapacity)
+			: writer(std::move(writer))
+			, capacity(std::max<size_t>(capacity, 1))
+			, buffer(std::make_unique<char[]>(this->capacity))
+		{}
+
+		explicit Appender(std::ostream & stream, size_t const capacity = DefaultCapacity)
+			: Appender([&stream](std::string_view const data) { stream.write(data.data(), static_cast<std::streamsize>(data.size())); }, capacity)
+		{}
+
+		explicit Appender(std::FILE * const file, size_t const capacity = DefaultCapacity)
+			: Appender(
+					[file](std::string_view const data)
+					{
+						if (std::fwrite(data.data(), 1, data.size(), file) != data.size())
+						{
+							throw std::runtime_error("File write failed");
+						}
+					},
+					capacity)
+		{}
+
+		explicit Appender(int const fd, size_t const capacity = DefaultCapacity)
+			: Appender([fd](std::string_view const data) { Compat::Write(fd, data.data(), data.size()); }, capacity)
+		{}
+
+		Appender(Appender const &) = delete;
+		Appender(Appender &&) = delete;
+		Appender & operator=(Appender const &) = delete;
+		Appender & operator=(Appender &&) = delete;
+
+		~Appender()
+		{
+			try
+			{
+				Flush();
+			}
+			catch (...) // NOLINT(bugprone-empty-catch) call Flush to see errors
+			{}
+		}
+
+		void Append(std::string_view const data)
+		{
+			if (data.size() <= capacity - size)
+			{
+				std::memcpy(buffer.get() + size, data.data(), data.size());
+				size += data.size();
+				return;
+			}
+
+			Flush();
+			if (data.size() >= capacity)
+			{
+				writer(data);
+				return;
+			}
+			std::memcpy(buffer.get(), data.data(), data.size());
+			size = data.size();
+		}
+
+		void Append(char const value)
+		{
+			if (size == capacity)
+			{
+				Flush();
+			}
+			buffer[size++] = value;
+		}
+
+		// a template so that string literals still choose the string_view overload
+		template <typename T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, char>> * = nullptr>
+		void Append(T const value)
+		{
+			if constexpr (std::is_same_v<T, bool>)
+			{
+				Append(std::string_view {value ? "true" : "false"});
+			}
+			else
+			{
+				// room for any integer and for %f of the largest double
+				constexpr size_t maxSize = 320;
+				char digits[maxSize]; // NOLINT(cppcoreguidelines-avoid-c-arrays) formatted in place
+
+				std::to_chars_result result {};
+				if constexpr (std::is_floating_point_v<T>)
+				{
+					constexpr int precision = 6;
+					result = std::to_chars(digits, digits + maxSize, static_cast<double>(value), std::chars_format::fixed, precision);
+				}
+				else
+				{
+					result = std::to_chars(digits, digits + maxSize, value);
+				}
+				Append(std::string_view {digits, static_cast<size_t>(result.ptr - digits)});
+			}
+		}
+
+		void Flush()
+		{
+			if (size != 0)
+			{
+				writer({buffer.get(), std::exchange(size, 0)});
+			}
+		}
+
+		[[nodiscard]] size_t Capacity() const
+		{
+			return capacity;
+		}
+
+		// buffered and not yet written
+		[[nodiscard]] std::string_view Pending() const
+		{
+			return {buffer.get(), size};
+		}
+	};
+}
@@ -99,6 +99,34 @@ namespace GLib::Compat
 	{
 		tzset();
 	}
+
+	// returns zero at end of file
+	inline size_t Read(int const fd, char * const buffer, size_t const size)
+	{
+		ssize_t result {};
+		do
+		{
+			result = ::read(fd, buffer, size);
+		} while (result == -1 && errno == EINTR);
+		AssertTrue(result != -1, "read", errno);
+		return static_cast<size_t>(result);
+	}
+
+	// writes all of buffer
+	inline void Write(int const fd, char const * buffer, size_t size)
+	{
+		while (size != 0)
+		{
+			ssize_t result {};
+			do
+			{
+				result = ::write(fd, buffer, size);
+			} while (result == -1 && errno == EINTR);
+			AssertTrue(result != -1, "write", errno);
+			buffer += result;
+			size -= static_cast<size_t>(result);
+		}
+	}
 }
 
 #endif
\ No newline at end of file
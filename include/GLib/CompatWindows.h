@@ -6,8 +6,11 @@
 #include <GLib/StackOrHeap.h>
 #include <GLib/Win/FileSystem.h>
 
+#include <algorithm>
 #include <ctime>
 #include <filesystem>
+#include <io.h>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -120,6 +123,28 @@ namespace GLib::Compat
 	{
 		_tzset();
 	}
+
+	// returns zero at end of file
+	inline size_t Read(int const fd, char * const buffer, size_t const size)
+	{
+		constexpr auto maxRead = static_cast<size_t>(std::numeric_limits<int>::max());
+		int const result = ::_read(fd, buffer, static_cast<unsigned int>((std::min)(size, maxRead)));
+		AssertTrue(result != -1, "_read", errno);
+		return static_cast<size_t>(result);
+	}
+
+	// writes all of buffer
+	inline void Write(int const fd, char const * buffer, size_t size)
+	{
+		constexpr auto maxWrite = static_cast<size_t>(std::numeric_limits<int>::max());
+		while (size != 0)
+		{
+			int const result = ::_write(fd, buffer, static_cast<unsigned int>((std::min)(size, maxWrite)));
+			AssertTrue(result != -1, "_write", errno);
+			buffer += result;
+			size -= static_cast<size_t>(result);
+		}
+	}
 }
 
 #endif
\ No newline at end of file
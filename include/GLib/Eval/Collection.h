@@ -58,6 +58,11 @@ namespace GLib::Eval
 				visitor(Value<typename Container::value_type> {value});
 			}
 		}
+
+		[[nodiscard]] void const * Type() const noexcept override
+		{
+			return &Detail::TypeKey<Collection>;
+		}
 	};
 
 	template <typename T>
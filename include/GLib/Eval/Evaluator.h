@@ -4,7 +4,17 @@
 #include <GLib/Split.h>
 
 #include <functional>
+#include <map>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/*
+names are held in slots, a value set for a name and a local value pushed over it share the slot
+a Binding is a path resolved once to its root slot, each step after that remembers the type it last saw and the index of
+the property in that type's table, so evaluating it again for values of the same types neither hashes nor compares names
+the remembered steps are updated by evaluation, an evaluator is used by one thread at a time
+*/
 
 namespace GLib::Eval
 {
@@ -15,121 +25,280 @@ namespace GLib::Eval
 		Visitor<T>::Visit(propertyName, value);
 	}
 
+	// a property name split on '.', so evaluating it does not split each time
+	using Path = std::vector<std::string>;
+
+	inline Path SplitPath(std::string const & name)
+	{
+		Path path;
+		for (auto const & token : Util::Splitter {name, "."})
+		{
+			path.push_back(token);
+		}
+		return path;
+	}
+
+	// handles from an evaluator, valid for its lifetime
+	enum class Binding : size_t
+	{
+	};
+
+	enum class Variable : size_t
+	{
+	};
+
 	class Evaluator
 	{
-		std::unordered_map<std::string, ValuePtr> values;
-		std::unordered_map<std::string, ValueBase const &> localValues;
+		struct Slot
+		{
+			std::string name;
+			ValuePtr value;
+			ValueBase const * local {};
+		};
 
-	public:
-		template <typename ValueType>
-		void Set(std::string const & name, ValueType value)
+		struct Step
 		{
-			ValuePtr valuePtr = MakeValue(value);
-			auto const iter = values.find(name);
+			void const * type {};
+			size_t index {};
+		};
 
-			if (iter == values.end())
-			{
-				values.emplace(name, std::move(valuePtr));
-			}
-			else
+		struct Bound
+		{
+			size_t slot {};
+			Path path;
+			std::vector<Step> steps;
+		};
+
+		// follows a path from its root value, uncached when steps is null
+		class Walk
+		{
+			Path const & path;
+			Step * const steps;
+			ValueVisitor const & visitor;
+			size_t position {1};
+
+		public:
+			Walk(Path const & path, Step * const steps, ValueVisitor const & visitor)
+				: path(path)
+				, steps(steps)
+				, visitor(visitor)
+			{}
+
+			void operator()(ValueBase const & value)
 			{
-				iter->second = std::move(valuePtr);
+				if (position == path.size())
+				{
+					return visitor(value);
+				}
+
+				std::string const & name = path[position];
+				auto const next = [this](ValueBase const & subValue) { (*this)(subValue); };
+				if (steps == nullptr)
+				{
+					++position;
+					return value.VisitProperty(name, next);
+				}
+
+				Step & step = steps[position - 1];
+				if (step.type != value.Type())
+				{
+					step = {value.Type(), value.PropertyIndex(name)};
+				}
+				++position;
+
+				if (step.index == NoPropertyIndex)
+				{
+					return value.VisitProperty(name, next);
+				}
+				value.VisitPropertyAt(step.index, next);
 			}
+		};
+
+		std::unordered_map<std::string, size_t> slotIndices;
+		std::vector<Slot> slots;
+		std::map<Path, size_t> boundIndices;
+		std::vector<Bound> bindings;
+
+	public:
+		template <typename ValueType>
+		void Set(std::string const & name, ValueType value)
+		{
+			slots[SlotIndex(name)].value = MakeValue(value);
 		}
 
 		// specialise add with IsCollection? allow value types?
 		template <typename Container>
 		void SetCollection(std::string const & name, Container const & container)
 		{
-			auto value = std::make_unique<Collection<Container>>(container);
-			auto const iter = values.find(name);
-
-			if (iter == values.end())
-			{
-				values.emplace(name, std::move(value));
-			}
-			else
-			{
-				iter->second = std::move(value);
-			}
+			slots[SlotIndex(name)].value = std::make_unique<Collection<Container>>(container);
 		}
 
 		void Remove(std::string const & name)
 		{
-			auto const iter = values.find(name);
-			if (iter == values.end())
+			auto const iter = slotIndices.find(name);
+			if (iter == slotIndices.end() || slots[iter->second].value == nullptr)
 			{
 				throw std::runtime_error("Value not found : " + name);
 			}
-			values.erase(iter);
+			slots[iter->second].value.reset();
+		}
+
+		[[nodiscard]] Variable GetVariable(std::string const & name)
+		{
+			return Variable {SlotIndex(name)};
 		}
 
 		void Push(std::string const & name, ValueBase const & value)
 		{
-			if (!localValues.emplace(name, value).second)
+			Push(GetVariable(name), value);
+		}
+
+		void Push(Variable const variable, ValueBase const & value)
+		{
+			Slot & slot = slots[static_cast<size_t>(variable)];
+			if (slot.local != nullptr)
 			{
-				throw std::runtime_error(std::string("Local value already exists : ") + name);
+				throw std::runtime_error(std::string("Local value already exists : ") + slot.name);
 			}
+			slot.local = &value;
 		}
 
 		void Pop(std::string const & name)
 		{
-			if (localValues.erase(name) == 0)
+			Pop(GetVariable(name));
+		}
+
+		void Pop(Variable const variable)
+		{
+			Slot & slot = slots[static_cast<size_t>(variable)];
+			if (slot.local == nullptr)
 			{
-				throw std::runtime_error(std::string("Local value not found : ") + name);
+				throw std::runtime_error(std::string("Local value not found : ") + slot.name);
 			}
+			slot.local = nullptr;
+		}
+
+		// the same path binds to the same handle
+		[[nodiscard]] Binding Bind(Path const & path)
+		{
+			if (path.empty())
+			{
+				throw std::logic_error("Path is empty");
+			}
+
+			auto const [iter, added] = boundIndices.try_emplace(path, bindings.size());
+			if (added)
+			{
+				bindings.push_back({SlotIndex(path.front()), path, std::vector<Step>(path.size() - 1)});
+			}
+			return Binding {iter->second};
 		}
 
 		void ForEach(std::string const & name, ValueVisitor const & visitor) const
 		{
-			Evaluate(name, [&](ValueBase const & value) { value.ForEach(visitor); });
+			ForEach(SplitPath(name), visitor);
+		}
+
+		void ForEach(Path const & path, ValueVisitor const & visitor) const
+		{
+			Evaluate(path, [&](ValueBase const & value) { value.ForEach(visitor); });
+		}
+
+		void ForEach(Binding const binding, ValueVisitor const & visitor)
+		{
+			Evaluate(binding, [&](ValueBase const & value) { value.ForEach(visitor); });
 		}
 
 		[[nodiscard]] std::string Evaluate(std::string const & name) const
+		{
+			return Evaluate(SplitPath(name));
+		}
+
+		[[nodiscard]] std::string Evaluate(Path const & path) const
+		{
+			std::string result;
+			Evaluate(path, [&](ValueBase const & value) { result = value.ToString(); });
+			return result;
+		}
+
+		[[nodiscard]] std::string Evaluate(Binding const binding)
 		{
 			std::string result;
-			Evaluate(name, [&](ValueBase const & value) { result = value.ToString(); });
+			Evaluate(binding, [&](ValueBase const & value) { result = value.ToString(); });
 			return result;
 		}
 
+		void Write(Binding const binding, Util::Appender & out)
+		{
+			Evaluate(binding, [&](ValueBase const & value) { value.Write(out); });
+		}
+
+		// a bool is read as it is, any other value must convert to "true" or "false"
+		[[nodiscard]] bool Condition(Binding const binding)
+		{
+			bool result {};
+			Evaluate(binding,
+							 [&](ValueBase const & value)
+							 {
+								 if (value.Type() == &Detail::TypeKey<bool>)
+								 {
+									 result = static_cast<Value<bool> const &>(value).Get();
+									 return;
+								 }
+
+								 std::string const text = value.ToString();
+								 if (text != "true" && text != "false")
+								 {
+									 throw std::runtime_error("Expected boolean value, got: " + text);
+								 }
+								 result = text == "true";
+							 });
+			return result;
+		}
+
+		void Evaluate(Binding const binding, ValueVisitor const & visitor)
+		{
+			Bound & bound = bindings[static_cast<size_t>(binding)];
+			Walk {bound.path, bound.steps.data(), visitor}(Current(slots[bound.slot]));
+		}
+
 	private:
-		void Evaluate(std::string const & value, ValueVisitor const & visitor) const
+		void Evaluate(Path const & path, ValueVisitor const & visitor) const
 		{
-			auto const & splitValue = Util::Splitter {value, "."};
-			auto iter = splitValue.begin();
+			if (path.empty())
+			{
+				throw std::logic_error("Path is empty");
+			}
 
-			auto const localIt = localValues.find(*iter);
-			if (localIt != localValues.end())
+			auto const iter = slotIndices.find(path.front());
+			if (iter == slotIndices.end())
 			{
-				++iter;
-				return SubEvaluate(localIt->second, iter, splitValue.end(), visitor);
+				throw std::runtime_error("Value not found : " + path.front());
 			}
+			Walk {path, nullptr, visitor}(Current(slots[iter->second]));
+		}
 
-			auto const valueIt = values.find(*iter);
-			if (valueIt == values.end())
+		size_t SlotIndex(std::string const & name)
+		{
+			auto const [iter, added] = slotIndices.try_emplace(name, slots.size());
+			if (added)
 			{
-				throw std::runtime_error("Value not found : " + *iter);
+				slots.push_back({name, {}, {}});
 			}
-			++iter;
-			SubEvaluate(*valueIt->second, iter, splitValue.end(), visitor);
+			return iter->second;
 		}
 
-		static void SubEvaluate(ValueBase const & value, Util::Splitter::Iterator & iter, Util::Splitter::Iterator const & end,
-														ValueVisitor const & visitor)
+		static ValueBase const & Current(Slot const & slot)
 		{
-			if (iter != end)
+			if (slot.local != nullptr)
 			{
-				value.VisitProperty(*iter,
-														[&](ValueBase const & subValue)
-														{
-															++iter;
-															SubEvaluate(subValue, iter, end, visitor);
-														});
+				return *slot.local;
 			}
-			else
+			if (slot.value == nullptr)
 			{
-				visitor(value);
+				throw std::runtime_error("Value not found : " + slot.name);
 			}
+			return *slot.value;
 		}
 	};
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <GLib/Appender.h>
 #include <GLib/Compat.h>
 
 #include <sstream>
@@ -34,6 +35,19 @@ namespace GLib::Eval::Utils
 			static constexpr bool value = decltype(test<T>(0))::value;
 		};
 
+		// a type can write itself with a free function AppendTo(Util::Appender &, T const &), found by argument dependent lookup
+		template <typename T>
+		struct HasAppendTo
+		{
+			template <typename C>
+			static auto test(int) -> decltype(AppendTo(std::declval<Util::Appender &>(), std::declval<C const &>()), std::true_type());
+
+			template <typename>
+			static auto test(...) -> decltype(std::false_type());
+
+			static constexpr bool value = decltype(test<T>(0))::value;
+		};
+
 		// basic container test has iterator, add begin\end.
 		template <typename T>
 		struct IsContainer
@@ -78,4 +92,26 @@ namespace GLib::Eval::Utils
 	{
 		return value;
 	}
-}
+
+	// as ToString, without a temporary string where the type allows
+	template <typename T>
+	void Write(Util::Appender & out, T const & value)
+	{
+		if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, long double>)
+		{
+			out.Append(value);
+		}
+		else if constexpr (std::is_convertible_v<T const &, std::string_view>)
+		{
+			out.Append(std::string_view {value});
+		}
+		else if constexpr (Detail::HasAppendTo<T>::value)
+		{
+			AppendTo(out, value);
+		}
+		else
+		{
+			out.Append(ToString(value));
+		}
+	}
+}
\ No newline at end of file
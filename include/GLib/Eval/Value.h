@@ -3,9 +3,12 @@
 #include <GLib/Compat.h>
 #include <GLib/Eval/Utils.h>
 
+#include <array>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace GLib::Eval
 {
@@ -19,6 +22,33 @@ namespace GLib::Eval
 	template <typename Value>
 	struct Visitor;
 
+	// an entry in a property table, a Visitor<T> that declares its properties as
+	// static constexpr std::array Properties {Property<T> {"name", accessor}, ...}
+	// is bound by index, otherwise Visit is called with the property name
+	template <typename T>
+	struct Property
+	{
+		std::string_view Name;
+		void (*Visit)(T const & value, ValueVisitor const & visitor);
+	};
+
+	inline constexpr size_t NoPropertyIndex = ~size_t {};
+
+	namespace Detail
+	{
+		template <typename T, typename = void>
+		struct HasProperties : std::false_type
+		{};
+
+		template <typename T>
+		struct HasProperties<T, std::void_t<decltype(Visitor<T>::Properties)>> : std::true_type
+		{};
+
+		// one address per type
+		template <typename T>
+		inline constexpr char TypeKey {};
+	}
+
 	template <typename ValueType>
 	ValuePtr MakeValue(ValueType value)
 	{
@@ -53,8 +83,31 @@ namespace GLib::Eval
 
 		[[nodiscard]] virtual std::string ToString() const = 0; // +format/stream?
 
+		// the same text as ToString
+		virtual void Write(Util::Appender & out) const
+		{
+			out.Append(ToString());
+		}
+
 		virtual void VisitProperty(std::string const & propertyName, ValueVisitor const & visitor) const = 0;
 		virtual void ForEach(ValueVisitor const & visitor) const = 0;
+
+		// the same for all values of a type
+		[[nodiscard]] virtual void const * Type() const noexcept = 0;
+
+		// index in the property table of the type, NoPropertyIndex when it has no table
+		[[nodiscard]] virtual size_t PropertyIndex(std::string const & propertyName) const
+		{
+			static_cast<void>(propertyName);
+			return NoPropertyIndex;
+		}
+
+		virtual void VisitPropertyAt(size_t const index, ValueVisitor const & visitor) const
+		{
+			static_cast<void>(index);
+			static_cast<void>(visitor);
+			throw std::logic_error("No property table");
+		}
 	};
 
 	template <typename ValueType>
@@ -67,20 +120,79 @@ namespace GLib::Eval
 			: value(std::move(value))
 		{}
 
+		[[nodiscard]] ValueType const & Get() const
+		{
+			return value;
+		}
+
 		[[nodiscard]] std::string ToString() const override
 		{
 			return Utils::ToString(value);
 		}
 
+		void Write(Util::Appender & out) const override
+		{
+			Utils::Write(out, value);
+		}
+
 		void VisitProperty(std::string const & propertyName, ValueVisitor const & visitor) const override
 		{
-			Visitor<ValueType>::Visit(value, propertyName, visitor);
+			if constexpr (Detail::HasProperties<ValueType>::value)
+			{
+				size_t const index = PropertyIndex(propertyName);
+				if (index == NoPropertyIndex)
+				{
+					throw std::runtime_error("Unknown property : '" + propertyName + '\'');
+				}
+				VisitPropertyAt(index, visitor);
+			}
+			else
+			{
+				Visitor<ValueType>::Visit(value, propertyName, visitor);
+			}
 		}
 
 		void ForEach(ValueVisitor const & visitor) const override
 		{
 			return Eval::ForEach(value, visitor);
 		}
+
+		[[nodiscard]] void const * Type() const noexcept override
+		{
+			return &Detail::TypeKey<ValueType>;
+		}
+
+		[[nodiscard]] size_t PropertyIndex(std::string const & propertyName) const override
+		{
+			if constexpr (Detail::HasProperties<ValueType>::value)
+			{
+				auto const & properties = Visitor<ValueType>::Properties;
+				for (size_t index = 0; index != properties.size(); ++index)
+				{
+					if (properties[index].Name == propertyName)
+					{
+						return index;
+					}
+				}
+			}
+			else
+			{
+				static_cast<void>(propertyName);
+			}
+			return NoPropertyIndex;
+		}
+
+		void VisitPropertyAt(size_t const index, ValueVisitor const & visitor) const override
+		{
+			if constexpr (Detail::HasProperties<ValueType>::value)
+			{
+				Visitor<ValueType>::Properties[index].Visit(value, visitor);
+			}
+			else
+			{
+				ValueBase::VisitPropertyAt(index, visitor);
+			}
+		}
 	};
 
 	template <typename Value>
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <GLib/Eval/Evaluator.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -8,6 +11,101 @@ namespace GLib::Html
 	class Node;
 	using NodeList = std::vector<Node>;
 
+	inline constexpr size_t NoSymbol = ~size_t {};
+
+	// literal text followed by an optional ${property}, an index into the template's symbols
+	struct Segment
+	{
+		std::string_view Literal;
+		size_t Property {NoSymbol};
+	};
+
+	// the property paths and variables of a template, which a render binds once each
+	class Symbols
+	{
+		std::vector<Eval::Path> paths;
+		std::vector<std::string> variables;
+
+	public:
+		[[nodiscard]] std::vector<Eval::Path> const & Paths() const
+		{
+			return paths;
+		}
+
+		[[nodiscard]] std::vector<std::string> const & Variables() const
+		{
+			return variables;
+		}
+
+		size_t AddPath(Eval::Path path)
+		{
+			return Add(paths, std::move(path));
+		}
+
+		size_t AddVariable(std::string name)
+		{
+			return Add(variables, std::move(name));
+		}
+
+	private:
+		template <typename T>
+		static size_t Add(std::vector<T> & values, T value)
+		{
+			auto const iter = std::find(values.begin(), values.end(), value);
+			if (iter != values.end())
+			{
+				return static_cast<size_t>(iter - values.begin());
+			}
+			values.push_back(std::move(value));
+			return values.size() - 1;
+		}
+	};
+
+	namespace Detail
+	{
+		inline bool IsPropertyChar(char const c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+		}
+
+		// finds the next ${name} at or after pos, matching as the regex \$\{([\w\.]+)\} did, npos if there is none
+		inline size_t FindProperty(std::string_view const value, size_t pos, std::string_view & name)
+		{
+			constexpr std::string_view open = "${";
+			for (pos = value.find(open, pos); pos != std::string_view::npos; pos = value.find(open, pos + 1))
+			{
+				size_t end = pos + open.size();
+				while (end != value.size() && IsPropertyChar(value[end]))
+				{
+					++end;
+				}
+				if (end != pos + open.size() && end != value.size() && value[end] == '}')
+				{
+					name = value.substr(pos + open.size(), end - pos - open.size());
+					return pos;
+				}
+			}
+			return std::string_view::npos;
+		}
+
+		inline std::vector<Segment> Split(std::string_view const value, Symbols & symbols)
+		{
+			std::vector<Segment> segments;
+			size_t start {};
+			std::string_view name;
+			for (size_t pos = FindProperty(value, start, name); pos != std::string_view::npos; pos = FindProperty(value, start, name))
+			{
+				segments.push_back({value.substr(start, pos - start), symbols.AddPath(Eval::SplitPath(std::string {name}))});
+				start = pos + name.size() + 3;
+			}
+			if (start != value.size())
+			{
+				segments.push_back({value.substr(start), NoSymbol});
+			}
+			return segments;
+		}
+	}
+
 	class Node
 	{
 		Node * const parent {};
@@ -18,6 +116,12 @@ namespace GLib::Html
 		NodeList children; // use ostream for xml fragments, single optional child for the rest, polymorphic?
 		size_t const depth {};
 
+		// set by Compile once the tree is complete
+		std::vector<Segment> segments;
+		size_t variableSymbol {NoSymbol};
+		size_t enumerationSymbol {NoSymbol};
+		size_t conditionSymbol {NoSymbol};
+
 	public:
 		Node() = default;
 
@@ -71,13 +175,53 @@ namespace GLib::Html
 			return children;
 		}
 
+		[[nodiscard]] std::vector<Segment> const & Segments() const
+		{
+			return segments;
+		}
+
+		[[nodiscard]] size_t VariableSymbol() const
+		{
+			return variableSymbol;
+		}
+
+		[[nodiscard]] size_t EnumerationSymbol() const
+		{
+			return enumerationSymbol;
+		}
+
+		// NoSymbol when the condition holds no property
+		[[nodiscard]] size_t ConditionSymbol() const
+		{
+			return conditionSymbol;
+		}
+
 		[[nodiscard]] size_t Depth() const
 		{
 			return depth;
 		}
 
+		[[nodiscard]] bool IsFragment() const
+		{
+			return !value.empty() && enumeration.empty() && condition.empty() && children.empty();
+		}
+
+		// joined to the previous fragment when it follows on in the template
 		void AddFragment(std::string_view const fragment)
 		{
+			if (fragment.empty())
+			{
+				return;
+			}
+
+			if (!children.empty())
+			{
+				if (Node & last = children.back(); last.IsFragment() && last.value.data() + last.value.size() == fragment.data())
+				{
+					last.value = {last.value.data(), last.value.size() + fragment.size()};
+					return;
+				}
+			}
 			children.emplace_back(this, fragment);
 		}
 
@@ -101,5 +245,24 @@ namespace GLib::Html
 		{
 			return &children.back();
 		}
+
+		// splits values into segments and names into symbols, after which rendering does no parsing
+		void Compile(Symbols & symbols)
+		{
+			segments = Detail::Split(value, symbols);
+			if (!enumeration.empty())
+			{
+				variableSymbol = symbols.AddVariable(variable);
+				enumerationSymbol = symbols.AddPath(Eval::SplitPath(enumeration));
+			}
+			if (std::string_view name; Detail::FindProperty(condition, 0, name) != std::string_view::npos)
+			{
+				conditionSymbol = symbols.AddPath(Eval::SplitPath(std::string {name}));
+			}
+			for (Node & child : children)
+			{
+				child.Compile(symbols);
+			}
+		}
 	};
 }
\ No newline at end of file
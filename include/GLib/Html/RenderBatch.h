@@ -0,0 +1,231 @@
+#pragma once
+
+#include <GLib/Cvt.h>
+#include <GLib/Html/TemplateEngine.h>
+#include <GLib/ParallelFor.h>
+#include <GLib/Scope.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+Rendering many pages, such as a coverage report with pages for each source file
+a job prepares an evaluator on a worker thread and renders its pages with it, the compiled templates are shared read only
+a job's Prepare is destroyed once its pages are rendered, so data its closure owns is held only while that job renders
+pages are rendered into memory and queued to one writer thread so file output overlaps rendering, the queue is bounded so
+renderers wait rather than hold every page when writing is the slower
+a page depends only on its job, so the files are the same for any thread count or order of completion
+*/
+
+namespace GLib::Html
+{
+	struct Page
+	{
+		CompiledTemplate const * Template {};
+		std::filesystem::path Path;
+	};
+
+	// Prepare sets the values the pages use, data set by reference must outlive the job's rendering, such as data owned by the closure
+	struct RenderJob
+	{
+		std::function<void(Eval::Evaluator &)> Prepare;
+		std::vector<Page> Pages;
+	};
+
+	struct RenderTiming
+	{
+		std::chrono::nanoseconds Prepare {};
+		std::chrono::nanoseconds Render {};
+		std::chrono::nanoseconds Write {};
+		size_t Bytes {};
+		std::string Error; // what() of the first exception, pages after it in the job are not rendered
+		std::exception_ptr Exception; // the same exception, for callers that fail as a whole
+
+		[[nodiscard]] bool Ok() const
+		{
+			return Error.empty();
+		}
+	};
+
+	namespace Detail
+	{
+		struct RenderedPage
+		{
+			size_t Job {};
+			std::filesystem::path const * Path {};
+			std::string Text;
+		};
+
+		class WriteQueue
+		{
+			std::mutex lock;
+			std::condition_variable changed;
+			std::deque<RenderedPage> pages;
+			size_t const capacity;
+			bool closed {};
+
+		public:
+			explicit WriteQueue(size_t const capacity)
+				: capacity(std::max<size_t>(capacity, 1))
+			{}
+
+			// waits while the queue is full
+			void Push(RenderedPage page)
+			{
+				std::unique_lock guard {lock};
+				changed.wait(guard, [&] { return pages.size() < capacity; });
+				pages.push_back(std::move(page));
+				changed.notify_all();
+			}
+
+			// waits for a page, empty once closed and drained
+			std::optional<RenderedPage> Pop()
+			{
+				std::unique_lock guard {lock};
+				changed.wait(guard, [&] { return !pages.empty() || closed; });
+				if (pages.empty())
+				{
+					return {};
+				}
+				RenderedPage page = std::move(pages.front());
+				pages.pop_front();
+				changed.notify_all();
+				return page;
+			}
+
+			void Close()
+			{
+				std::lock_guard const guard {lock};
+				closed = true;
+				changed.notify_all();
+			}
+		};
+
+		// text mode, as pages were written with an ofstream
+		inline void WritePage(std::filesystem::path const & path, std::string_view const text)
+		{
+			if (path.has_parent_path())
+			{
+				create_directories(path.parent_path());
+			}
+
+			std::ofstream out(path);
+			if (!out)
+			{
+				throw std::runtime_error("Unable to create file : " + Cvt::P2A(path));
+			}
+			out.write(text.data(), static_cast<std::streamsize>(text.size()));
+			out.close();
+			if (!out)
+			{
+				throw std::runtime_error("Unable to write file : " + Cvt::P2A(path));
+			}
+		}
+	}
+
+	// renders the jobs using up to threads threads, zero for the hardware concurrency, with one more thread writing
+	// returns timings in job order, a std::exception fails only its job
+	inline std::vector<RenderTiming> RenderBatch(std::vector<RenderJob> jobs, size_t const threads = 0)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		std::vector<RenderTiming> timings(jobs.size());
+		std::vector<std::chrono::nanoseconds> writeTimes(jobs.size());
+		std::vector<std::exception_ptr> writeErrors(jobs.size());
+
+		constexpr size_t pagesPerThread = 2;
+		Detail::WriteQueue queue {ThreadCount(jobs.size(), threads) * pagesPerThread};
+
+		std::jthread writer {[&]
+												 {
+													 for (auto page = queue.Pop(); page; page = queue.Pop())
+													 {
+														 auto const start = Clock::now();
+														 try
+														 {
+															 Detail::WritePage(*page->Path, page->Text);
+														 }
+														 catch (std::exception const &)
+														 {
+															 if (!writeErrors[page->Job])
+															 {
+																 writeErrors[page->Job] = std::current_exception();
+															 }
+														 }
+														 writeTimes[page->Job] += Clock::now() - start;
+													 }
+												 }};
+
+		{
+			auto const close = GLib::Detail::Scope([&] { queue.Close(); });
+			ParallelFor(jobs.size(),
+									threads,
+									[&](size_t const index)
+									{
+										RenderJob & job = jobs[index];
+										RenderTiming & timing = timings[index];
+										try
+										{
+											Eval::Evaluator evaluator;
+											auto start = Clock::now();
+											if (job.Prepare)
+											{
+												job.Prepare(evaluator);
+											}
+											timing.Prepare = Clock::now() - start;
+
+											Generator generator {evaluator};
+											for (Page const & page : job.Pages)
+											{
+												start = Clock::now();
+												std::string text;
+												{
+													Util::Appender out {[&](std::string_view const data) { text.append(data); }};
+													generator.Generate(*page.Template, out);
+													out.Flush(); // the destructor would swallow a failure to append the last block
+												}
+												timing.Render += Clock::now() - start;
+												timing.Bytes += text.size();
+												queue.Push({index, &page.Path, std::move(text)});
+											}
+										}
+										catch (std::exception const & e)
+										{
+											timing.Error = e.what();
+											timing.Exception = std::current_exception();
+										}
+										job.Prepare = nullptr;
+									});
+		}
+		writer.join();
+
+		for (size_t index = 0; index < jobs.size(); ++index)
+		{
+			RenderTiming & timing = timings[index];
+			timing.Write = writeTimes[index];
+			if (timing.Ok() && writeErrors[index])
+			{
+				timing.Exception = writeErrors[index];
+				try
+				{
+					std::rethrow_exception(timing.Exception);
+				}
+				catch (std::exception const & e)
+				{
+					timing.Error = e.what();
+				}
+			}
+		}
+		return timings;
+	}
+}
@@ -2,48 +2,41 @@
 
 #include "Node.h"
 
+#include <GLib/Appender.h>
 #include <GLib/Eval/Evaluator.h>
-#include <GLib/PairHash.h>
 #include <GLib/Xml/Iterator.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <regex>
+#include <shared_mutex>
+
+/*
+a template is parsed into a Node tree of fragments that view the xml, contiguous fragments are joined as they are added
+a CompiledTemplate owns its xml and tree, is not changed by rendering and so can be rendered by any number of generators at once
+a TemplateCache holds compiled templates by id for the life of the cache
+output goes to a Util::Appender, values write into it without a temporary string, an ostream is written in large blocks
+*/
 
 namespace GLib::Html
 {
-	class Generator
+	// parses a template into a tree that views the xml
+	class Compiler
 	{
-		using AttributeMap = std::unordered_map<std::pair<std::string_view, std::string_view>, Xml::Attribute, Util::PairHash>;
-
 		static constexpr auto mainNameSpace = std::string_view {"glib"};
 		static constexpr auto block = std::string_view {"block"};
 		static constexpr auto each = std::string_view {"each"};
 		static constexpr auto if_ = std::string_view {"if"};
 		static constexpr auto text = std::string_view {"text"};
 
-		std::regex const propRegex {R"(\$\{([\w\.]+)\})"};
 		std::regex const varRegex {R"(^(\w+)\s:\s\$\{([\w\.]+)\}$)"};
 
-		Eval::Evaluator & evaluator;
 		std::string_view textReplacement;
 
 	public:
-		explicit Generator(Eval::Evaluator & evaluator)
-			: evaluator(evaluator)
-		{}
-
-		void Generate(std::string_view const xml, std::ostream & out)
-		{
-			Generate(Parse(xml), out);
-		}
-
-	private:
-		static char const * EndOf(std::string_view const value)
-		{
-			return value.data() + value.size();
-		}
-
-		Node Parse(std::string_view const xml)
+		Node Parse(std::string_view const xml, Symbols & symbols)
 		{
 			Node root; // hack?
 			Node * current = &root;
@@ -65,6 +58,7 @@ namespace GLib::Html
 				}
 			}
 
+			root.Compile(symbols);
 			return root;
 		}
 
@@ -72,15 +66,19 @@ namespace GLib::Html
 		{
 			std::string_view eachValue;
 			std::string_view ifValue;
-			for (auto const && [name, value, nameSpace, rawValue] : element.GetAttributes())
+			for (Xml::IndexedAttribute const & attribute : element.IndexedAttributes())
 			{
-				if (name == each)
+				if (attribute.Declaration)
+				{
+					continue;
+				}
+				if (attribute.Name == each)
 				{
-					eachValue = value;
+					eachValue = attribute.Value;
 				}
-				else if (name == if_)
+				else if (attribute.Name == if_)
 				{
-					ifValue = value;
+					ifValue = attribute.Value;
 				}
 			}
 
@@ -189,12 +187,24 @@ namespace GLib::Html
 			return node->Back();
 		}
 
-		static Node * ProcessAttributes(Node * node, Xml::NameSpaceManager const & manager, AttributeMap const & atMap,
-																		Xml::Attributes const & attributes)
+		// a glib attribute other than the actions replaces the value of the unqualified attribute with the same name
+		static std::string_view ReplacedValue(Xml::AttributeIndex const & attributes, Xml::IndexedAttribute const & attribute)
 		{
-			for (auto const && [name2, value2, nameSpace2, rawValue2] : attributes)
+			if (attribute.Name != if_ && attribute.Name != each && attribute.Name != text)
 			{
-				if (std::string_view const prefix = Xml::NameSpaceManager::CheckForDeclaration(name2); !prefix.empty())
+				if (Xml::IndexedAttribute const * const replacement = attributes.Find(attribute.Name, mainNameSpace); replacement != nullptr)
+				{
+					return replacement->Value;
+				}
+			}
+			return attribute.Value;
+		}
+
+		static Node * ProcessAttributes(Node * node, Xml::NameSpaceManager const & manager, Xml::AttributeIndex const & attributes)
+		{
+			for (Xml::IndexedAttribute const & attribute : attributes)
+			{
+				if (std::string_view const prefix = Xml::NameSpaceManager::CheckForDeclaration(attribute.QName); !prefix.empty())
 				{
 					if (std::string_view const nameSpace = manager.Get(prefix); nameSpace == mainNameSpace)
 					{
@@ -202,39 +212,30 @@ namespace GLib::Html
 					}
 
 					node->AddFragment(" ");
-					node->AddFragment(rawValue2);
+					node->AddFragment(attribute.RawValue);
 				}
-				else
+				else if (attribute.NameSpace.empty())
 				{
-					auto && [name, nameSpace] = manager.Normalise(name2);
-					if (nameSpace.empty())
-					{
-						node->AddFragment(" ");
-						node->AddFragment(name.data(), value2.data());
-
-						auto const iter = atMap.find(std::make_pair(nameSpace, name));
-						if (iter == atMap.cend())
-						{
-							throw std::runtime_error {"Namespace not found: " + std::string {nameSpace}};
-						}
-						node->AddFragment(iter->second.Value);
-						node->AddFragment(value2.data() - 1, value2.data());
-					}
+					node->AddFragment(" ");
+					node->AddFragment(attribute.QName.data(), attribute.Value.data());
+					node->AddFragment(ReplacedValue(attributes, attribute));
+					node->AddFragment(attribute.Value.data() - 1, attribute.Value.data());
 				}
 			}
 			return node;
 		}
 
 		static Node * ProcessDeclarations(Xml::Element const & element, Node * node, Xml::NameSpaceManager const & manager,
-																			Xml::Attributes const & attributes)
+																			Xml::AttributeIndex const & attributes)
 		{
 			std::string_view ptr = element.OuterXml();
-			for (auto const && [name, value, nameSpace, rawValue] : attributes)
+			for (Xml::IndexedAttribute const & attribute : attributes)
 			{
-				if (std::string_view const prefix = Xml::NameSpaceManager::CheckForDeclaration(name); !prefix.empty() && manager.Get(prefix) == mainNameSpace)
+				if (std::string_view const prefix = Xml::NameSpaceManager::CheckForDeclaration(attribute.QName);
+						!prefix.empty() && manager.Get(prefix) == mainNameSpace)
 				{
-					node->AddFragment(ptr, name.data() - 1); // -1 minus space prefix
-					ptr = EndOf(rawValue);
+					node->AddFragment(ptr, attribute.QName.data() - 1); // -1 minus space prefix
+					ptr = EndOf(attribute.RawValue);
 				}
 			}
 			node->AddFragment(ptr, EndOf(element.OuterXml()));
@@ -243,67 +244,56 @@ namespace GLib::Html
 
 		std::string_view ProcessElement(Xml::Element const & element, Node *& node, Xml::NameSpaceManager const & manager) const
 		{
-			AttributeMap atMap;
 			bool modified = false;
 			std::string_view textValue;
 			std::string_view ifValue;
 			std::string_view eachValue;
 
 			std::string_view const attributesValue = element.GetAttributes().Value();
-			Xml::Attributes const attributes {attributesValue, nullptr};
+			Xml::AttributeIndex const & attributes = element.IndexedAttributes();
 			bool pop {};
 
 			// handle duplicate attr names?
-			for (Xml::Attribute const && attr : attributes)
-			{
-				if (!Xml::NameSpaceManager::IsDeclaration(attr.Name))
-				{
-					auto const && [name, nameSpace] = manager.Normalise(attr.Name);
-					atMap.emplace(std::make_pair(nameSpace, name), attr);
-				}
-			}
-
-			for (auto && [nameSpaceName, attr] : atMap)
+			for (Xml::IndexedAttribute const & attribute : attributes)
 			{
-				if (nameSpaceName.first != mainNameSpace)
+				if (attribute.Declaration || attribute.NameSpace != mainNameSpace || attributes.Find(attribute.Name, mainNameSpace) != &attribute)
 				{
 					continue;
 				}
 
-				if (nameSpaceName.second == if_)
+				if (attribute.Name == if_)
 				{
-					ifValue = attr.Value;
+					ifValue = attribute.Value;
 					modified = true;
 					continue;
 				}
 
-				if (nameSpaceName.second == each)
+				if (attribute.Name == each)
 				{
-					eachValue = attr.Value;
+					eachValue = attribute.Value;
 					modified = true;
 					continue;
 				}
 
-				if (nameSpaceName.second == text && element.Type() != Xml::ElementType::Open)
+				if (attribute.Name == text && element.Type() != Xml::ElementType::Open)
 				{
 					throw std::runtime_error {"Misplaced Attribute"};
 				}
 
-				if (nameSpaceName.second == text && element.Type() == Xml::ElementType::Open)
+				if (attribute.Name == text && element.Type() == Xml::ElementType::Open)
 				{
-					textValue = attr.Value;
+					textValue = attribute.Value;
 					modified = true;
 					continue;
 				}
 
-				if (auto const existingIt = atMap.find(std::make_pair("", nameSpaceName.second)); existingIt != atMap.end())
+				if (attributes.Find(attribute.Name, {}) != nullptr)
 				{
-					existingIt->second.Value = attr.Value;
 					modified = true;
 					continue;
 				}
 
-				throw std::runtime_error {"Attribute not found : '" + std::string {nameSpaceName.second} + "'"};
+				throw std::runtime_error {"Attribute not found : '" + std::string {attribute.Name} + "'"};
 			}
 
 			if (!eachValue.empty())
@@ -329,7 +319,7 @@ namespace GLib::Html
 			if (modified)
 			{
 				node->AddFragment(element.OuterXml().data(), attributesValue.data() - 1);
-				node = ProcessAttributes(node, manager, atMap, attributes);
+				node = ProcessAttributes(node, manager, attributes);
 				node->AddFragment(EndOf(attributesValue), EndOf(element.OuterXml()));
 			}
 			else
@@ -345,7 +335,90 @@ namespace GLib::Html
 			return textValue;
 		}
 
-		void Generate(Node const & node, std::ostream & out)
+		static char const * EndOf(std::string_view const value)
+		{
+			return value.data() + value.size();
+		}
+	};
+
+	class CompiledTemplate
+	{
+		std::string const source;
+		Symbols symbols;
+		Node const root;
+
+	public:
+		explicit CompiledTemplate(std::string source)
+			: source(std::move(source))
+			, root(Compiler {}.Parse(this->source, symbols))
+		{}
+
+		// the tree views the source
+		CompiledTemplate(CompiledTemplate const &) = delete;
+		CompiledTemplate(CompiledTemplate &&) = delete;
+		CompiledTemplate & operator=(CompiledTemplate const &) = delete;
+		CompiledTemplate & operator=(CompiledTemplate &&) = delete;
+		~CompiledTemplate() = default;
+
+		[[nodiscard]] Node const & Root() const
+		{
+			return root;
+		}
+
+		[[nodiscard]] Symbols const & GetSymbols() const
+		{
+			return symbols;
+		}
+	};
+
+	class Generator
+	{
+		Eval::Evaluator & evaluator;
+		std::vector<Eval::Binding> bindings;
+		std::vector<Eval::Variable> variables;
+
+	public:
+		explicit Generator(Eval::Evaluator & evaluator)
+			: evaluator(evaluator)
+		{}
+
+		void Generate(std::string_view const xml, std::ostream & out)
+		{
+			CompiledTemplate const compiled {std::string {xml}};
+			Generate(compiled, out);
+		}
+
+		void Generate(CompiledTemplate const & compiled, std::ostream & out)
+		{
+			Util::Appender appender {out};
+			Generate(compiled, appender);
+			appender.Flush();
+		}
+
+		// output is left in the appender until it fills or is flushed
+		void Generate(CompiledTemplate const & compiled, Util::Appender & out)
+		{
+			Bind(compiled.GetSymbols());
+			Generate(compiled.Root(), out);
+		}
+
+	private:
+		void Bind(Symbols const & symbols)
+		{
+			bindings.clear();
+			for (Eval::Path const & path : symbols.Paths())
+			{
+				bindings.push_back(evaluator.Bind(path));
+			}
+
+			variables.clear();
+			for (std::string const & name : symbols.Variables())
+			{
+				variables.push_back(evaluator.GetVariable(name));
+			}
+		}
+
+		void Generate(Node const & node, Util::Appender & out)
 		{
 			// todo eval during parse, store bool or property to evaluate
 			std::string_view const condition = node.Condition();
@@ -356,67 +429,42 @@ namespace GLib::Html
 
 			if (!condition.empty() && condition != "true")
 			{
-				std::match_results<std::string_view::const_iterator> match;
-				std::regex_search(condition.begin(), condition.end(), match, propRegex);
-				if (match.empty())
+				if (node.ConditionSymbol() == NoSymbol)
 				{
 					throw std::runtime_error("Error in if value : " + std::string(condition));
 				}
 
-				std::string const result = evaluator.Evaluate(match[1]);
-				if (result == "false")
+				if (!evaluator.Condition(bindings[node.ConditionSymbol()]))
 				{
 					return;
 				}
-
-				if (result != "true")
-				{
-					throw std::runtime_error("Expected boolean value, got: " + result);
-				}
 			}
 
 			if (!node.Enumeration().empty())
 			{
+				Eval::Variable const variable = variables[node.VariableSymbol()];
 				auto subGenerate = [&](Eval::ValueBase const & value)
 				{
-					evaluator.Push(node.Variable(), value);
+					evaluator.Push(variable, value);
 
 					for (Node const & child : node.Children())
 					{
 						Generate(child, out);
 					}
 
-					evaluator.Pop(node.Variable());
+					evaluator.Pop(variable);
 				};
 
-				evaluator.ForEach(node.Enumeration(), subGenerate);
+				evaluator.ForEach(bindings[node.EnumerationSymbol()], subGenerate);
 				return;
 			}
 
-			if (!node.Value().empty())
+			for (Segment const & segment : node.Segments())
 			{
-				std::regex const prop(propRegex);
-				std::cregex_iterator iter(node.Value().data(), EndOf(node.Value()), prop);
-				auto const end = std::cregex_iterator {};
-				if (iter == end)
-				{
-					out << node.Value();
-				}
-				else
+				out.Append(segment.Literal);
+				if (segment.Property != NoSymbol)
 				{
-					for (;;)
-					{
-						out << iter->prefix();
-						auto const & var = (*iter)[1]; // +format;
-						out << evaluator.Evaluate(var);
-						std::csub_match const & suffix = iter++->suffix();
-
-						if (iter == end)
-						{
-							out << suffix;
-							break;
-						}
-					}
+					evaluator.Write(bindings[segment.Property], out);
 				}
 			}
 
@@ -427,8 +475,70 @@ namespace GLib::Html
 		}
 	};
 
+	// templates compiled once and shared, safe to use from several threads
+	class TemplateCache
+	{
+		mutable std::shared_mutex lock;
+		std::map<std::string, std::unique_ptr<CompiledTemplate const>, std::less<>> templates;
+
+	public:
+		CompiledTemplate const & Add(std::string id, std::string source)
+		{
+			auto compiled = std::make_unique<CompiledTemplate const>(std::move(source));
+			std::unique_lock const writeLock {lock};
+			auto const [it, added] = templates.try_emplace(std::move(id), std::move(compiled));
+			if (!added)
+			{
+				throw std::runtime_error("Template already exists : " + it->first);
+			}
+			return *it->second;
+		}
+
+		[[nodiscard]] CompiledTemplate const * Find(std::string_view const id) const
+		{
+			std::shared_lock const readLock {lock};
+			auto const it = templates.find(id);
+			return it == templates.end() ? nullptr : it->second.get();
+		}
+
+		[[nodiscard]] CompiledTemplate const & Get(std::string_view const id) const
+		{
+			if (CompiledTemplate const * const compiled = Find(id); compiled != nullptr)
+			{
+				return *compiled;
+			}
+			throw std::runtime_error("Template not found : " + std::string {id});
+		}
+
+		// compiles load() on first use of the id
+		template <typename Loader>
+		CompiledTemplate const & Get(std::string_view const id, Loader const & load)
+		{
+			if (CompiledTemplate const * const compiled = Find(id); compiled != nullptr)
+			{
+				return *compiled;
+			}
+
+			auto compiled = std::make_unique<CompiledTemplate const>(load());
+			std::unique_lock const writeLock {lock};
+			auto const [it, added] = templates.try_emplace(std::string {id}, std::move(compiled));
+			static_cast<void>(added); // another thread may have compiled it first
+			return *it->second;
+		}
+	};
+
 	inline void Generate(Eval::Evaluator & eval, std::string_view const xml, std::ostream & out)
 	{
 		Generator(eval).Generate(xml, out);
 	}
+
+	inline void Generate(Eval::Evaluator & eval, CompiledTemplate const & compiled, std::ostream & out)
+	{
+		Generator(eval).Generate(compiled, out);
+	}
+
+	inline void Generate(Eval::Evaluator & eval, CompiledTemplate const & compiled, Util::Appender & out)
+	{
+		Generator(eval).Generate(compiled, out);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <GLib/Compat.h>
+#include <GLib/Scope.h>
+
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#include <GLib/Win/Handle.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+Read only memory mapping of a whole file, sequential access hinted
+the view can be passed straight to Xml::Holder and Cpp::Holder so parsing needs no copy
+*/
+
+namespace GLib
+{
+	class MappedFile
+	{
+		char const * data {};
+		size_t size {};
+
+	public:
+		explicit MappedFile(std::filesystem::path const & path)
+		{
+			Map(path);
+		}
+
+		MappedFile(MappedFile const &) = delete;
+		MappedFile & operator=(MappedFile const &) = delete;
+
+		MappedFile(MappedFile && other) noexcept
+			: data(std::exchange(other.data, nullptr))
+			, size(std::exchange(other.size, 0))
+		{}
+
+		MappedFile & operator=(MappedFile && other) noexcept
+		{
+			if (this != &other)
+			{
+				Unmap();
+				data = std::exchange(other.data, nullptr);
+				size = std::exchange(other.size, 0);
+			}
+			return *this;
+		}
+
+		~MappedFile()
+		{
+			Unmap();
+		}
+
+		[[nodiscard]] std::string_view View() const
+		{
+			return {data, size};
+		}
+
+		operator std::string_view() const // NOLINT(google-explicit-constructor) pass directly to the holders
+		{
+			return View();
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return size;
+		}
+
+	private:
+#if defined(_WIN32)
+		void Map(std::filesystem::path const & path)
+		{
+			Win::HandleBase * const fileHandle =
+				CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			Win::Util::AssertTrue(fileHandle != INVALID_HANDLE_VALUE, "CreateFileW");
+			Win::Handle const file {fileHandle};
+
+			LARGE_INTEGER fileSize {};
+			Win::Util::AssertTrue(GetFileSizeEx(file.get(), &fileSize), "GetFileSizeEx");
+			if (fileSize.QuadPart == 0)
+			{
+				return; // cannot map an empty file
+			}
+
+			Win::HandleBase * const mappingHandle = CreateFileMappingW(file.get(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+			Win::Util::AssertTrue(mappingHandle != nullptr, "CreateFileMappingW");
+			Win::Handle const mapping {mappingHandle}; // the view keeps its own reference
+
+			void * const view = MapViewOfFile(mapping.get(), FILE_MAP_READ, 0, 0, 0);
+			Win::Util::AssertTrue(view != nullptr, "MapViewOfFile");
+
+			data = static_cast<char const *>(view);
+			size = static_cast<size_t>(fileSize.QuadPart);
+		}
+
+		void Unmap() noexcept
+		{
+			if (data != nullptr)
+			{
+				Win::Util::WarnAssertTrue(UnmapViewOfFile(data), "UnmapViewOfFile");
+			}
+		}
+#elif defined(__linux__)
+		void Map(std::filesystem::path const & path)
+		{
+			int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(cppcoreguidelines-pro-type-vararg)
+			Compat::AssertTrue(fd != -1, "open", errno);
+			auto const closer = Detail::Scope([fd] { ::close(fd); }); // the mapping keeps its own reference
+
+			struct stat status {};
+			Compat::AssertTrue(::fstat(fd, &status) != -1, "fstat", errno);
+			if (status.st_size == 0)
+			{
+				return; // cannot map an empty file
+			}
+
+			void * const view = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			Compat::AssertTrue(view != MAP_FAILED, "mmap", errno);
+
+			static_cast<void>(::madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL)); // hint only
+			data = static_cast<char const *>(view);
+			size = static_cast<size_t>(status.st_size);
+		}
+
+		void Unmap() noexcept
+		{
+			if (data != nullptr)
+			{
+				::munmap(const_cast<char *>(data), size); // NOLINT(cppcoreguidelines-pro-type-const-cast)
+			}
+		}
+#endif
+	};
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GLib
+{
+	// the number of threads ParallelFor uses, zero for the hardware concurrency
+	inline size_t ThreadCount(size_t const count, size_t const threads)
+	{
+		return std::min(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads, count);
+	}
+
+	// calls function(worker, index) for every index in [0, count) using up to threads threads, zero for the hardware concurrency
+	// worker is below ThreadCount(count, threads) and calls with the same worker are never concurrent, for per thread state
+	// indices are handed out in small batches, the calling thread also does work
+	// after an exception no more batches are started and the first exception is rethrown once all threads have finished
+	template <typename Function>
+	void ParallelForWorkers(size_t const count, size_t const requested, Function const & function)
+	{
+		size_t const threads = ThreadCount(count, requested);
+		if (threads <= 1)
+		{
+			for (size_t index = 0; index < count; ++index)
+			{
+				function(size_t {}, index);
+			}
+			return;
+		}
+
+		constexpr size_t batchesPerThread = 16;
+		size_t const batchSize = std::max<size_t>(count / (threads * batchesPerThread), 1);
+
+		std::atomic<size_t> next {};
+		std::atomic<bool> failed {};
+		std::exception_ptr error;
+		std::mutex errorLock;
+
+		auto const work = [&](size_t const worker)
+		{
+			for (size_t begin = next.fetch_add(batchSize); begin < count && !failed; begin = next.fetch_add(batchSize))
+			{
+				try
+				{
+					for (size_t index = begin, end = std::min(begin + batchSize, count); index < end; ++index)
+					{
+						function(worker, index);
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard const lock {errorLock};
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+					failed = true;
+				}
+			}
+		};
+
+		{
+			std::vector<std::jthread> workers;
+			workers.reserve(threads - 1);
+			for (size_t thread = 1; thread < threads; ++thread)
+			{
+				workers.emplace_back(work, thread);
+			}
+			work(size_t {});
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
+	// calls function(index) for every index in [0, count), as ParallelForWorkers
+	template <typename Function>
+	void ParallelFor(size_t const count, size_t const threads, Function const & function)
+	{
+		ParallelForWorkers(count, threads, [&](size_t, size_t const index) { function(index); });
+	}
+}
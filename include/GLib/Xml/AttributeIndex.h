@@ -0,0 +1,171 @@
+#pragma once
+
+#include <GLib/Xml/Attributes.h>
+
+#include <array>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+/*
+the attributes of one element tokenised on the first lookup and kept, later lookups scan a few entries without re-parsing
+the first few entries live inline, an iterator owns one index and resets it per element so warmed up lookups do not allocate
+declarations are included, named by their qualified name with no namespace
+*/
+
+namespace GLib::Xml
+{
+	struct IndexedAttribute
+	{
+		std::string_view QName;
+		std::string_view Name;
+		std::string_view NameSpace;
+		std::string_view Value;
+		std::string_view RawValue;
+		bool Declaration {};
+
+		// Value with entities decoded, Value itself if it has none
+		[[nodiscard]] std::string_view DecodedValue(std::string & buffer) const
+		{
+			return Utils::Decode(Value, buffer);
+		}
+	};
+
+	class AttributeIndex
+	{
+		static constexpr size_t inlineCount = 8;
+
+		Attributes attributes;
+		mutable std::array<IndexedAttribute, inlineCount> inlineEntries {};
+		mutable std::pmr::vector<IndexedAttribute> overflow; // holds all the entries once there are more than fit inline
+		mutable size_t count {};
+		mutable bool built {true};
+
+	public:
+		AttributeIndex() = default;
+
+		explicit AttributeIndex(std::pmr::memory_resource * const resource)
+			: overflow(resource)
+		{}
+
+		explicit AttributeIndex(Attributes const & attributes)
+		{
+			Reset(attributes);
+		}
+
+		// copies allocate from the same resource
+		AttributeIndex(AttributeIndex const & other)
+			: attributes(other.attributes)
+			, inlineEntries(other.inlineEntries)
+			, overflow(other.overflow, other.Resource())
+			, count(other.count)
+			, built(other.built)
+		{}
+
+		AttributeIndex(AttributeIndex &&) noexcept = default;
+		AttributeIndex & operator=(AttributeIndex const &) = default;
+		AttributeIndex & operator=(AttributeIndex &&) = default; // NOLINT(performance-noexcept-move-constructor)
+		~AttributeIndex() = default;
+
+		[[nodiscard]] std::pmr::memory_resource * Resource() const
+		{
+			return overflow.get_allocator().resource();
+		}
+
+		// index another element's attributes, storage is kept
+		void Reset(Attributes const & value)
+		{
+			attributes = value;
+			overflow.clear();
+			count = 0;
+			built = attributes.Empty();
+		}
+
+		[[nodiscard]] std::span<IndexedAttribute const> Entries() const
+		{
+			Build();
+			return {overflow.empty() ? inlineEntries.data() : overflow.data(), count};
+		}
+
+		[[nodiscard]] auto begin() const
+		{
+			return Entries().begin();
+		}
+
+		[[nodiscard]] auto end() const
+		{
+			return Entries().end();
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return Entries().size();
+		}
+
+		// by qualified name, declarations included
+		[[nodiscard]] IndexedAttribute const * Find(std::string_view const qName) const
+		{
+			for (IndexedAttribute const & entry : Entries())
+			{
+				if (entry.QName == qName)
+				{
+					return &entry;
+				}
+			}
+			return nullptr;
+		}
+
+		// by local name and namespace, declarations excluded
+		[[nodiscard]] IndexedAttribute const * Find(std::string_view const name, std::string_view const nameSpace) const
+		{
+			for (IndexedAttribute const & entry : Entries())
+			{
+				if (!entry.Declaration && entry.Name == name && entry.NameSpace == nameSpace)
+				{
+					return &entry;
+				}
+			}
+			return nullptr;
+		}
+
+	private:
+		void Build() const
+		{
+			if (built)
+			{
+				return;
+			}
+			built = true;
+
+			NameSpaceManager const * const manager = attributes.Manager();
+			for (auto const & [qName, value, nameSpace, rawValue] : Attributes {attributes.Value()})
+			{
+				static_cast<void>(nameSpace);
+				IndexedAttribute entry {qName, qName, {}, value, rawValue, false};
+				entry.Declaration = NameSpaceManager::IsDeclaration(qName) || NameSpaceManager::IsDefaultDeclaration(qName);
+				if (!entry.Declaration && manager != nullptr)
+				{
+					std::tie(entry.Name, entry.NameSpace) = manager->Normalise(qName);
+				}
+				Push(entry);
+			}
+		}
+
+		void Push(IndexedAttribute const & entry) const
+		{
+			if (count < inlineCount)
+			{
+				inlineEntries[count] = entry;
+			}
+			else
+			{
+				if (overflow.empty())
+				{
+					overflow.assign(inlineEntries.begin(), inlineEntries.end());
+				}
+				overflow.push_back(entry);
+			}
+			++count;
+		}
+	};
+}
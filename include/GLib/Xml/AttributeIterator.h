@@ -1,6 +1,7 @@
 #pragma once
 
 #include <GLib/Xml/NameSpaceManager.h>
+#include <GLib/Xml/Scanner.h>
 #include <GLib/Xml/StateEngine.h>
 #include <GLib/Xml/Utils.h>
 
@@ -16,6 +17,12 @@ namespace GLib::Xml
 		std::string_view Value;
 		std::string_view NameSpace;
 		std::string_view RawValue;
+
+		// Value with entities decoded, Value itself if it has none
+		[[nodiscard]] std::string_view DecodedValue(std::string & buffer) const
+		{
+			return Utils::Decode(Value, buffer);
+		}
 	};
 
 	class AttributeIterator
@@ -79,6 +86,15 @@ namespace GLib::Xml
 		}
 
 	private:
+		void SkipValue()
+		{
+			if (ptr != end)
+			{
+				char const * const begin = &*ptr;
+				ptr += Scanner::Find(begin, begin + (end - ptr), Scanner::Delimiters<3> {engine.QuoteChar(), '&', '<'}) - begin;
+			}
+		}
+
 		[[noreturn]] void IllegalCharacter(char const chr) const
 		{
 			std::ostringstream stm;
@@ -122,7 +138,7 @@ namespace GLib::Xml
 				{
 					if (newState == State::AttributeEntity || oldState == State::AttributeEntity)
 					{
-						continue; // currently ignoring entities, receiver needs to decode
+						continue; // entities are passed on, see Attribute::DecodedValue
 					}
 
 					switch (oldState)
@@ -136,7 +152,8 @@ namespace GLib::Xml
 						case State::AttributeValue:
 						{
 							attributeValue.second = oldPtr;
-							if (manager == nullptr || !NameSpaceManager::IsDeclaration(Utils::ToStringView(attributeName)))
+							if (auto const name = Utils::ToStringView(attributeName);
+									manager == nullptr || !(NameSpaceManager::IsDeclaration(name) || NameSpaceManager::IsDefaultDeclaration(name)))
 							{
 								return;
 							}
@@ -160,6 +177,7 @@ namespace GLib::Xml
 						case State::AttributeValue:
 						{
 							attributeValue.first = ptr;
+							SkipValue();
 							break;
 						}
 
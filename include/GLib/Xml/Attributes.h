@@ -42,5 +42,10 @@ namespace GLib::Xml
 		{
 			return data;
 		}
+
+		[[nodiscard]] NameSpaceManager const * Manager() const
+		{
+			return manager;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <GLib/Xml/Iterator.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+Declarative binding of elements and attributes to struct members
+a Schema lists the fields of one struct and is built at compile time into two perfect hash tables, one for attributes and one for child elements
+a name is hashed once, its slot holds the only field it can be, one comparison confirms it and a switch over the field index assigns the member
+values are converted straight from the input, entities are decoded into one buffer for the whole document, no strings or maps are built on the way
+names are the local name and namespace resolved by the NameSpaceManager, unknown attributes are ignored and unknown elements skipped
+*/
+
+namespace GLib::Xml::Bind
+{
+	// an unqualified name only matches names in no namespace
+	struct Name
+	{
+		std::string_view NameSpace;
+		std::string_view Local;
+
+		constexpr Name() = default;
+
+		constexpr Name(char const * const local) // NOLINT(google-explicit-constructor) names are usually literals
+			: Local(local)
+		{}
+
+		constexpr Name(std::string_view const nameSpace, std::string_view const local)
+			: NameSpace(nameSpace)
+			, Local(local)
+		{}
+	};
+
+	namespace Detail
+	{
+		enum class Kind : uint8_t
+		{
+			Attribute,
+			Text,
+			Child
+		};
+
+		template <typename T>
+		struct IsVector : std::false_type
+		{};
+
+		template <typename T, typename Allocator>
+		struct IsVector<std::vector<T, Allocator>> : std::true_type
+		{};
+
+		template <typename T>
+		struct IsOptional : std::false_type
+		{};
+
+		template <typename T>
+		struct IsOptional<std::optional<T>> : std::true_type
+		{};
+
+		// the type of one value of a member
+		template <typename T>
+		struct ValueType
+		{
+			using Type = T;
+		};
+
+		template <typename T, typename Allocator>
+		struct ValueType<std::vector<T, Allocator>>
+		{
+			using Type = T;
+		};
+
+		template <typename T>
+		struct ValueType<std::optional<T>>
+		{
+			using Type = T;
+		};
+
+		template <typename Member>
+		inline constexpr bool IsString = std::is_same_v<typename ValueType<Member>::Type, std::string>;
+
+		// vector and optional members take a new value for each occurrence
+		template <typename Member>
+		auto & NewValue(Member & member)
+		{
+			if constexpr (IsVector<Member>::value)
+			{
+				return member.emplace_back();
+			}
+			else if constexpr (IsOptional<Member>::value)
+			{
+				return member.emplace();
+			}
+			else
+			{
+				return member;
+			}
+		}
+
+		// the value last made for a member, for appending
+		template <typename Member>
+		auto & ValueOf(Member & member)
+		{
+			if constexpr (IsVector<Member>::value)
+			{
+				return member.back();
+			}
+			else if constexpr (IsOptional<Member>::value)
+			{
+				return *member;
+			}
+			else
+			{
+				return member;
+			}
+		}
+
+		// the namespace takes part by its length and last character, enough to tell apart namespaces used together
+		constexpr uint64_t Hash(std::string_view const nameSpace, std::string_view const local, uint64_t const seed)
+		{
+			constexpr uint64_t basis = 0xCBF29CE484222325ULL;
+			constexpr uint64_t prime = 0x100000001B3ULL;
+			constexpr unsigned int foldShift = 32;
+
+			uint64_t hash = basis ^ seed;
+			for (char const character : local)
+			{
+				hash = (hash ^ static_cast<unsigned char>(character)) * prime;
+			}
+			hash = (hash ^ nameSpace.size()) * prime;
+			if (!nameSpace.empty())
+			{
+				hash = (hash ^ static_cast<unsigned char>(nameSpace.back())) * prime;
+			}
+			return hash ^ (hash >> foldShift);
+		}
+
+		struct Entry
+		{
+			Name name;
+			uint8_t index {};
+		};
+
+		template <size_t Count>
+		class Table
+		{
+			static constexpr size_t Size = std::bit_ceil(std::max<size_t>(2 * Count, 1));
+			static constexpr uint64_t SeedLimit = 1U << 12U;
+
+			std::array<uint8_t, Size> slots {}; // field index + 1, zero for none
+			uint64_t seed {};
+
+		public:
+			constexpr explicit Table(std::array<Entry, Count> const & entries)
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					for (size_t j = 0; j < i; ++j)
+					{
+						if (entries[i].name.Local == entries[j].name.Local && entries[i].name.NameSpace == entries[j].name.NameSpace)
+						{
+							throw std::logic_error("Name bound twice");
+						}
+					}
+				}
+
+				for (; !Fill(entries); ++seed)
+				{
+					if (seed == SeedLimit)
+					{
+						throw std::logic_error("No perfect hash for the names");
+					}
+				}
+			}
+
+			// field index + 1, zero if no field can have the name
+			[[nodiscard]] constexpr size_t Find(std::string_view const nameSpace, std::string_view const local) const
+			{
+				return slots[Hash(nameSpace, local, seed) & (Size - 1)];
+			}
+
+		private:
+			constexpr bool Fill(std::array<Entry, Count> const & entries)
+			{
+				slots = {};
+				for (Entry const & entry : entries)
+				{
+					auto & slot = slots[Hash(entry.name.NameSpace, entry.name.Local, seed) & (Size - 1)];
+					if (slot != 0)
+					{
+						return false;
+					}
+					slot = static_cast<uint8_t>(entry.index + 1);
+				}
+				return true;
+			}
+		};
+
+		template <typename>
+		inline constexpr bool AlwaysFalse = false;
+
+		[[noreturn]] inline void InvalidValue(Name const & name, std::string_view const value)
+		{
+			throw std::runtime_error("Invalid value for " + std::string(name.Local) + ": '" + std::string(value) + '\'');
+		}
+
+		// {namespace}local, or local when in no namespace
+		inline std::string Describe(std::string_view const nameSpace, std::string_view const local)
+		{
+			return nameSpace.empty() ? std::string(local) : '{' + std::string(nameSpace) + '}' + std::string(local);
+		}
+
+		inline std::string_view Trim(std::string_view const value)
+		{
+			constexpr std::string_view space = " \t\r\n";
+			size_t const first = value.find_first_not_of(space);
+			return first == std::string_view::npos ? std::string_view {} : value.substr(first, value.find_last_not_of(space) - first + 1);
+		}
+
+		// strings take the value as it is, numbers and bools ignore surrounding white space
+		template <typename T>
+		void Convert(Name const & name, std::string_view const value, T & out)
+		{
+			if constexpr (std::is_same_v<T, std::string>)
+			{
+				out.assign(value);
+			}
+			else if constexpr (std::is_same_v<T, bool>)
+			{
+				auto const trimmed = Trim(value);
+				if (trimmed == "true" || trimmed == "1")
+				{
+					out = true;
+				}
+				else if (trimmed == "false" || trimmed == "0")
+				{
+					out = false;
+				}
+				else
+				{
+					InvalidValue(name, value);
+				}
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				auto const trimmed = Trim(value);
+				char const * const end = trimmed.data() + trimmed.size();
+				auto const [ptr, error] = std::from_chars(trimmed.data(), end, out);
+				if (error != std::errc {} || ptr != end || trimmed.empty())
+				{
+					InvalidValue(name, value);
+				}
+			}
+			else
+			{
+				static_assert(AlwaysFalse<T>, "No conversion for the member type");
+			}
+		}
+
+		// text can come in pieces around comments or ignored elements
+		// a string takes each piece as it comes, other values are converted once from the pieces joined
+		template <typename Member>
+		void AddText(Name const & name, std::string_view const piece, Member & member, std::string & joined, bool const first)
+		{
+			if constexpr (IsString<Member>)
+			{
+				static_cast<void>(joined);
+				if (first)
+				{
+					Convert(name, piece, NewValue(member));
+				}
+				else
+				{
+					ValueOf(member).append(piece);
+				}
+			}
+			else
+			{
+				static_cast<void>(name);
+				static_cast<void>(member);
+				if (first)
+				{
+					joined.clear();
+				}
+				joined.append(piece);
+			}
+		}
+
+		template <typename Member>
+		void EndText(Name const & name, Member & member, std::string const & joined)
+		{
+			if constexpr (!IsString<Member>)
+			{
+				Convert(name, joined, NewValue(member));
+			}
+		}
+	}
+
+	template <typename Class, typename Member>
+	struct AttributeField
+	{
+		static constexpr Detail::Kind kind = Detail::Kind::Attribute;
+		using ClassType = Class;
+
+		Name name;
+		Member Class::*member;
+	};
+
+	// the text of the element itself
+	template <typename Class, typename Member>
+	struct TextField
+	{
+		static constexpr Detail::Kind kind = Detail::Kind::Text;
+		using ClassType = Class;
+
+		Name name;
+		Member Class::*member;
+	};
+
+	// a child element whose text is the value
+	template <typename Class, typename Member>
+	struct ChildField
+	{
+		static constexpr Detail::Kind kind = Detail::Kind::Child;
+		using ClassType = Class;
+
+		Name name;
+		Member Class::*member;
+	};
+
+	// a child element read by its own schema
+	template <typename Class, typename Member, typename ChildSchema>
+	struct ObjectField
+	{
+		static constexpr Detail::Kind kind = Detail::Kind::Child;
+		using ClassType = Class;
+
+		Name name;
+		Member Class::*member;
+		ChildSchema schema;
+	};
+
+	template <typename Class, typename Member>
+	constexpr AttributeField<Class, Member> Attribute(Name const name, Member Class::*const member)
+	{
+		return {name, member};
+	}
+
+	template <typename Class, typename Member>
+	constexpr TextField<Class, Member> Text(Member Class::*const member)
+	{
+		return {{}, member};
+	}
+
+	template <typename Class, typename Member>
+	constexpr ChildField<Class, Member> Child(Name const name, Member Class::*const member)
+	{
+		return {name, member};
+	}
+
+	template <typename Class, typename Member, typename ChildSchema>
+	constexpr ObjectField<Class, Member, ChildSchema> Child(Name const name, Member Class::*const member, ChildSchema const & schema)
+	{
+		return {name, member, schema};
+	}
+
+	// members may be strings, numbers, bools, or vectors and optionals of them, child objects as well
+	template <typename Class, typename... Fields>
+	class Schema
+	{
+		template <Detail::Kind Kind>
+		static constexpr size_t Count = ((Fields::kind == Kind ? 1U : 0U) + ... + 0U);
+
+		static_assert((std::is_same_v<typename Fields::ClassType, Class> && ...), "Fields of another class");
+		static_assert(Count<Detail::Kind::Text> <= 1, "One text field at most");
+		static_assert(sizeof...(Fields) < UINT8_MAX, "Too many fields");
+
+		using Tuple = std::tuple<Fields...>;
+		Tuple fields;
+		Detail::Table<Count<Detail::Kind::Attribute>> attributes;
+		Detail::Table<Count<Detail::Kind::Child>> children;
+
+	public:
+		constexpr explicit Schema(Fields const &... values)
+			: fields(values...)
+			, attributes(Entries<Detail::Kind::Attribute>(fields))
+			, children(Entries<Detail::Kind::Child>(fields))
+		{}
+
+		// it is on the Open or Empty element for object, and is left on its Close, or on the Empty element
+		void Read(Iterator & it, Class & object, std::string & buffer) const
+		{
+			for (auto const & attribute : it->GetAttributes())
+			{
+				Dispatch<Detail::Kind::Attribute>(attributes, attribute.NameSpace, attribute.Name,
+																					[&](auto const & field)
+																					{
+																						auto & value = Detail::NewValue(object.*field.member);
+																						Detail::Convert(field.name, attribute.DecodedValue(buffer), value);
+																					});
+			}
+
+			if (it->Type() == ElementType::Empty)
+			{
+				return;
+			}
+
+			std::string joined;
+			for (bool textRead {};;)
+			{
+				++it;
+				switch (it->Type())
+				{
+					case ElementType::Close:
+					{
+						if constexpr (Count<Detail::Kind::Text> != 0)
+						{
+							if (textRead)
+							{
+								OnTextField(object, [&](auto const & field, auto & member) { Detail::EndText(field.name, member, joined); });
+							}
+						}
+						return;
+					}
+
+					case ElementType::Text:
+					{
+						if constexpr (Count<Detail::Kind::Text> != 0)
+						{
+							OnTextField(object, [&](auto const & field, auto & member)
+													{ Detail::AddText(field.name, it->DecodedText(buffer), member, joined, !textRead); });
+							textRead = true;
+						}
+						break;
+					}
+
+					case ElementType::Open:
+					case ElementType::Empty:
+					{
+						if (!Dispatch<Detail::Kind::Child>(children, it->NameSpace(), it->Name(),
+																							 [&](auto const & field) { ReadChild(field, it, object, buffer); }))
+						{
+							it.SkipSubtree();
+						}
+						break;
+					}
+
+					default:
+					{
+						break;
+					}
+				}
+			}
+		}
+
+	private:
+		template <Detail::Kind Kind>
+		static constexpr std::array<Detail::Entry, Count<Kind>> Entries(Tuple const & fields)
+		{
+			std::array<Detail::Entry, Count<Kind>> entries {};
+			size_t next {};
+			[&]<size_t... I>(std::index_sequence<I...>)
+			{
+				((std::tuple_element_t<I, Tuple>::kind == Kind ? static_cast<void>(entries[next++] = {std::get<I>(fields).name, static_cast<uint8_t>(I)})
+																											 : static_cast<void>(0)),
+				 ...);
+			}(std::index_sequence_for<Fields...> {});
+			return entries;
+		}
+
+		// calls function(field) with the field of kind Kind that has the name, a switch over the field index
+		template <Detail::Kind Kind, typename Table, typename Function>
+		bool Dispatch(Table const & table, std::string_view const nameSpace, std::string_view const local, Function const & function) const
+		{
+			size_t const slot = table.Find(nameSpace, local);
+			if (slot == 0)
+			{
+				return false;
+			}
+
+			auto const visit = [&](auto const & field)
+			{
+				if constexpr (std::remove_cvref_t<decltype(field)>::kind == Kind)
+				{
+					if (field.name.Local == local && field.name.NameSpace == nameSpace)
+					{
+						function(field);
+						return true;
+					}
+				}
+				return false;
+			};
+
+			return [&]<size_t... I>(std::index_sequence<I...>)
+			{
+				bool found {};
+				static_cast<void>(((slot - 1 == I && (found = visit(std::get<I>(fields)), true)) || ...));
+				return found;
+			}(std::index_sequence_for<Fields...> {});
+		}
+
+		// function(field, member) for the text field
+		template <typename Function>
+		void OnTextField(Class & object, Function const & function) const
+		{
+			[&]<size_t... I>(std::index_sequence<I...>)
+			{
+				(
+					[&](auto const & field)
+					{
+						if constexpr (std::remove_cvref_t<decltype(field)>::kind == Detail::Kind::Text)
+						{
+							function(field, object.*field.member);
+						}
+					}(std::get<I>(fields)),
+					...);
+			}(std::index_sequence_for<Fields...> {});
+		}
+
+		template <typename Member>
+		static void ReadChild(ChildField<Class, Member> const & field, Iterator & it, Class & object, std::string & buffer)
+		{
+			auto & member = object.*field.member;
+			std::string joined;
+			bool textRead {};
+			if (it->Type() == ElementType::Open)
+			{
+				for (++it; it->Type() != ElementType::Close; ++it)
+				{
+					if (it->Type() == ElementType::Text)
+					{
+						Detail::AddText(field.name, it->DecodedText(buffer), member, joined, !textRead);
+						textRead = true;
+					}
+					else
+					{
+						it.SkipSubtree();
+					}
+				}
+			}
+			if (!textRead)
+			{
+				Detail::Convert(field.name, {}, Detail::NewValue(member));
+			}
+			else
+			{
+				Detail::EndText(field.name, member, joined);
+			}
+		}
+
+		template <typename Member, typename ChildSchema>
+		static void ReadChild(ObjectField<Class, Member, ChildSchema> const & field, Iterator & it, Class & object, std::string & buffer)
+		{
+			field.schema.Read(it, Detail::NewValue(object.*field.member), buffer);
+		}
+	};
+
+	template <typename First, typename... Rest>
+	Schema(First, Rest...) -> Schema<typename First::ClassType, First, Rest...>;
+
+	// the root element, which must have the name, read into a Class, the rest of the document is still parsed and checked
+	template <typename Class, typename... Fields, typename HolderType>
+	Class Read(Name const & root, Schema<Class, Fields...> const & schema, HolderType && holder)
+	{
+		Class object {};
+		std::string buffer;
+		auto it = holder.begin();
+		auto const end = holder.end();
+		while (it->Type() == ElementType::Comment)
+		{
+			++it;
+		}
+		if (it->Name() != root.Local || it->NameSpace() != root.NameSpace)
+		{
+			throw std::runtime_error("Root element mismatch: " + Detail::Describe(it->NameSpace(), it->Name()) + " != " +
+															 Detail::Describe(root.NameSpace, root.Local));
+		}
+		schema.Read(it, object, buffer);
+		for (++it; it != end; ++it)
+		{}
+		return object;
+	}
+}
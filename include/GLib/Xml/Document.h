@@ -0,0 +1,283 @@
+#pragma once
+
+#include <GLib/Xml/Iterator.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/*
+A read only tree built in one pass over the Element stream, so it keeps the parser's validation
+nodes live in one array in document order linked by parent, first child and next sibling indices
+attributes of all elements live in a second array, each element owns a contiguous range
+names, text and values are views into the source, which must outlive the document
+namespaces are copied once each into the document, a value with entities is decoded by the parser into storage that lasts only while it is in scope
+lookups by name walk the sibling links, a linear scan of the children, which is cheap for the fan out of typical documents
+*/
+
+namespace GLib::Xml
+{
+	class Document
+	{
+	public:
+		using Index = uint32_t;
+		static constexpr Index None = std::numeric_limits<Index>::max();
+
+		class Node
+		{
+			friend class Document;
+
+			std::string_view value; // qualified name of elements, text of text nodes and comments
+			std::string_view nameSpace;
+			Index nameOffset {};
+			Index parent {None};
+			Index firstChild {None};
+			Index nextSibling {None};
+			Index firstAttribute {};
+			Index attributeCount {};
+			ElementType type {};
+
+		public:
+			// Open for elements with content, Empty, Text or Comment
+			[[nodiscard]] ElementType Type() const
+			{
+				return type;
+			}
+
+			[[nodiscard]] bool IsElement() const
+			{
+				return type == ElementType::Open || type == ElementType::Empty;
+			}
+
+			[[nodiscard]] std::string_view QName() const
+			{
+				return IsElement() ? value : std::string_view {};
+			}
+
+			[[nodiscard]] std::string_view Name() const
+			{
+				return QName().substr(nameOffset);
+			}
+
+			[[nodiscard]] std::string_view NameSpace() const
+			{
+				return nameSpace;
+			}
+
+			[[nodiscard]] std::string_view Text() const
+			{
+				return IsElement() ? std::string_view {} : value;
+			}
+
+			[[nodiscard]] Index Parent() const
+			{
+				return parent;
+			}
+
+			[[nodiscard]] Index FirstChild() const
+			{
+				return firstChild;
+			}
+
+			[[nodiscard]] Index NextSibling() const
+			{
+				return nextSibling;
+			}
+		};
+
+	private:
+		std::vector<Node> nodes;
+		std::vector<Attribute> attributes;
+		std::deque<std::string> nameSpaces; // distinct values, a deque so the views stay put
+		Index root {None};
+
+	public:
+		explicit Document(std::string_view const xml)
+		{
+			Holder holder {xml};
+			Build(holder);
+		}
+
+		// the holder's input must outlive the document
+		explicit Document(Holder & holder)
+		{
+			Build(holder);
+		}
+
+		// nodes view the namespaces it holds
+		Document(Document const &) = delete;
+		Document(Document &&) = default;
+		Document & operator=(Document const &) = delete;
+		Document & operator=(Document &&) = default;
+		~Document() = default;
+
+		// the first element
+		[[nodiscard]] Index Root() const
+		{
+			return root;
+		}
+
+		[[nodiscard]] Node const & Get(Index const index) const
+		{
+			return nodes[index];
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return nodes.size();
+		}
+
+		[[nodiscard]] std::span<Attribute const> Attributes(Index const index) const
+		{
+			Node const & node = nodes[index];
+			return {attributes.data() + node.firstAttribute, node.attributeCount};
+		}
+
+		// first child element named name in nameSpace, an empty nameSpace is no namespace as for attributes
+		[[nodiscard]] Index Child(Index const parent, std::string_view const name, std::string_view const nameSpace = {}) const
+		{
+			return Find(nodes[parent].firstChild, [&](Node const & node) { return node.Name() == name && node.nameSpace == nameSpace; });
+		}
+
+		// first child element named name whatever its namespace
+		[[nodiscard]] Index ChildInAnyNameSpace(Index const parent, std::string_view const name) const
+		{
+			return Find(nodes[parent].firstChild, [&](Node const & node) { return node.Name() == name; });
+		}
+
+		// next sibling element with the same name and namespace, for iterating repeated children
+		[[nodiscard]] Index NextNamed(Index const sibling) const
+		{
+			Node const & from = nodes[sibling];
+			return Find(from.nextSibling, [&](Node const & node) { return node.Name() == from.Name() && node.nameSpace == from.nameSpace; });
+		}
+
+		// raw value, entities are not decoded, see Attribute::DecodedValue
+		[[nodiscard]] std::optional<std::string_view> AttributeValue(Index const index, std::string_view const name,
+																																 std::string_view const nameSpace = {}) const
+		{
+			for (Attribute const & attribute : Attributes(index))
+			{
+				if (attribute.Name == name && attribute.NameSpace == nameSpace)
+				{
+					return attribute.Value;
+				}
+			}
+			return {};
+		}
+
+		// bytes held by the node and attribute arrays, the source is not included
+		[[nodiscard]] size_t MemoryUsage() const
+		{
+			return nodes.capacity() * sizeof(Node) + attributes.capacity() * sizeof(Attribute);
+		}
+
+		[[nodiscard]] double BytesPerNode() const
+		{
+			return nodes.empty() ? 0 : static_cast<double>(MemoryUsage()) / static_cast<double>(nodes.size());
+		}
+
+	private:
+		template <typename Match>
+		[[nodiscard]] Index Find(Index index, Match const & match) const
+		{
+			for (; index != None; index = nodes[index].nextSibling)
+			{
+				if (Node const & node = nodes[index]; node.IsElement() && match(node))
+				{
+					return index;
+				}
+			}
+			return None;
+		}
+
+		void Build(Holder & holder)
+		{
+			struct Level
+			{
+				Index parent;
+				Index lastChild;
+			};
+			std::vector<Level> levels {{None, None}};
+
+			for (auto const & element : holder)
+			{
+				if (element.Type() == ElementType::Close)
+				{
+					levels.pop_back();
+					continue;
+				}
+
+				auto const index = static_cast<Index>(nodes.size());
+				AssertTrue(index != None, "Document too large");
+
+				Level & level = levels.back();
+				Node & node = nodes.emplace_back();
+				node.type = element.Type();
+				node.parent = level.parent;
+				if (level.lastChild == None)
+				{
+					if (level.parent != None)
+					{
+						nodes[level.parent].firstChild = index;
+					}
+				}
+				else
+				{
+					nodes[level.lastChild].nextSibling = index;
+				}
+				level.lastChild = index;
+
+				if (!node.IsElement())
+				{
+					node.value = element.Text();
+					continue;
+				}
+
+				node.value = element.QName();
+				node.nameOffset = static_cast<Index>(element.QName().size() - element.Name().size());
+				node.nameSpace = Intern(element.NameSpace());
+				node.firstAttribute = static_cast<Index>(attributes.size());
+				for (auto const & attribute : element.GetAttributes())
+				{
+					Attribute & copy = attributes.emplace_back(attribute);
+					copy.NameSpace = Intern(attribute.NameSpace);
+				}
+				node.attributeCount = static_cast<Index>(attributes.size()) - node.firstAttribute;
+
+				if (root == None)
+				{
+					root = index;
+				}
+				if (element.Type() == ElementType::Open)
+				{
+					levels.push_back({index, None});
+				}
+			}
+		}
+
+		// documents use a handful of namespaces, the most recent is the likeliest
+		std::string_view Intern(std::string_view const value)
+		{
+			if (value.empty())
+			{
+				return {};
+			}
+			auto const it = std::find(nameSpaces.rbegin(), nameSpaces.rend(), value);
+			return it != nameSpaces.rend() ? *it : nameSpaces.emplace_back(value);
+		}
+
+		static void AssertTrue(bool const value, char const * message)
+		{
+			if (!value)
+			{
+				throw std::runtime_error(message);
+			}
+		}
+	};
+}
@@ -1,6 +1,10 @@
 #pragma once
 
-#include <GLib/Xml/Attributes.h>
+#include <GLib/Xml/AttributeIndex.h>
+#include <GLib/Xml/Position.h>
+#include <GLib/Xml/Utils.h>
+
+#include <memory>
 
 namespace GLib::Xml
 {
@@ -13,6 +17,45 @@ namespace GLib::Xml
 		Comment
 	};
 
+	namespace Detail
+	{
+		// the index of the element an iterator is on belongs to the iterator, a copy of the element builds its own on first use
+		class ElementIndex
+		{
+			AttributeIndex const * attached {};
+			mutable std::unique_ptr<AttributeIndex> own;
+
+		public:
+			ElementIndex() = default;
+			ElementIndex(ElementIndex const & /*other*/) noexcept {}
+			ElementIndex & operator=(ElementIndex const & /*other*/) noexcept
+			{
+				attached = nullptr;
+				own.reset();
+				return *this;
+			}
+			~ElementIndex() = default;
+
+			void Attach(AttributeIndex const * const index)
+			{
+				attached = index;
+			}
+
+			[[nodiscard]] AttributeIndex const & Get(Attributes const & attributes) const
+			{
+				if (attached != nullptr)
+				{
+					return *attached;
+				}
+				if (!own)
+				{
+					own = std::make_unique<AttributeIndex>(attributes);
+				}
+				return *own;
+			}
+		};
+	}
+
 	class Element
 	{
 		friend class Iterator; // avoid
@@ -25,6 +68,9 @@ namespace GLib::Xml
 		Attributes attributes;
 		size_t depth {};			 // move/remove?
 		std::string_view text; // value?
+		Detail::ElementIndex index;
+		size_t offset {};
+		char const * input {}; // held in full, null when streamed
 
 	public:
 		Element(std::string_view const qName, std::string_view const name, std::string_view const nameSpace, ElementType const type,
@@ -80,6 +126,30 @@ namespace GLib::Xml
 			return attributes;
 		}
 
+		// tokenised on first use and kept, the iterator's is reused per element, a copy allocates its own
+		// namespaces resolve as they do for GetAttributes, so a copy should be indexed while its declarations are in scope
+		[[nodiscard]] AttributeIndex const & IndexedAttributes() const
+		{
+			return index.Get(attributes);
+		}
+
+		// of the first character in the document
+		[[nodiscard]] size_t Offset() const
+		{
+			return offset;
+		}
+
+		// line and column of Offset, counted from the start of the input on each call so copies can ask too
+		// Iterator::GetPosition is cheaper for elements in document order, and the only way for streamed input that is no longer held
+		[[nodiscard]] Position GetPosition() const
+		{
+			if (input == nullptr)
+			{
+				throw std::logic_error("No position for an element of streamed input, see Iterator::GetPosition");
+			}
+			return PositionOf(input, offset);
+		}
+
 		[[nodiscard]] size_t Depth() const // move/remove?
 		{
 			return depth;
@@ -89,5 +159,11 @@ namespace GLib::Xml
 		{
 			return text;
 		}
+
+		// Text with entities decoded, Text itself if it has none
+		[[nodiscard]] std::string_view DecodedText(std::string & buffer) const
+		{
+			return Utils::Decode(text, buffer);
+		}
 	};
 }
\ No newline at end of file
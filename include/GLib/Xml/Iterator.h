@@ -2,22 +2,29 @@
 
 #include <GLib/Xml/Element.h>
 #include <GLib/Xml/NameSpaceManager.h>
+#include <GLib/Xml/Position.h>
+#include <GLib/Xml/Scanner.h>
+#include <GLib/Xml/Source.h>
 #include <GLib/Xml/StateEngine.h>
+#include <GLib/Xml/Utf8.h>
 #include <GLib/Xml/Utils.h>
 
 #include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
+#include <vector>
 
 /*
 Design:
 xml input is a contiguous sequence of utf8 characters
 string_view's are used to hold pieces of the xml input to avoid copying
+or streamed from a Source, the buffer is rebased when refilled and element names and namespaces are copied
+a Source that is not finished suspends the iterator at the end of its data, see PushParser
+optional UTF-8 checking in the same pass, per character in the state loop and per run where the scanner skips
+only byte offsets are kept while parsing, line and column are counted from them for errors, Iterator::GetPosition and Element::GetPosition
+working data allocates from the namespace manager's memory resource, error messages are only built when thrown
 separate attribute iterator exposed, enumerated first for namespaces then for values
-
-todo:
-improve error message to include error detail line\column numbers
-default namespace
-standard entities
 */
 
 namespace GLib::Xml
@@ -30,11 +37,13 @@ namespace GLib::Xml
 		StateEngine engine;
 
 		std::string_view::const_iterator ptr {};
-		std::string_view::const_iterator const end {};
+		std::string_view::const_iterator end {};
 		std::optional<std::string_view::const_iterator> lastPtr;
 		NameSpaceManager * manager = {};
+		Source * source = {};
 
 		/////////// element working data, could just use element storage
+		// the iterators always point into the buffer, never default constructed, so a refill can rebase them all
 		ElementType elementType {};
 		Utils::PtrPair elementName;
 		Utils::PtrPair attributes;
@@ -46,9 +55,15 @@ namespace GLib::Xml
 		///////////
 
 		Element element;
-		std::stack<std::string_view> elementStack;
-		unsigned int line {};
-		unsigned int pos {};
+		AttributeIndex attributeIndex; // the element refers to it, repointed on copy
+		std::pmr::vector<std::string_view> elementStack;
+		std::pmr::vector<char> streamedNames; // stream mode, copies of the open names in stack order
+		std::optional<size_t> closedDepth; // namespaces are popped on the next increment so the element can still use them
+		bool suspended {};
+		bool validateUtf8 {};
+		Utf8::State utf8 {};
+		Lines lines;
+		char const * input {}; // held in full, elements work out their own positions from it
 
 	public:
 		// ReSharper disable All
@@ -60,17 +75,105 @@ namespace GLib::Xml
 
 		// ReSharper restore All
 
-		Iterator(std::string_view::const_iterator begin, std::string_view::const_iterator const end, NameSpaceManager * manager)
+		Iterator(std::string_view::const_iterator begin, std::string_view::const_iterator const end, NameSpaceManager * manager,
+						 Utf8::Validation const validation = Utf8::Validation::Off)
 			: ptr(begin)
 			, end(end)
 			, lastPtr(begin)
 			, manager(manager)
+			, elementName(begin, begin)
+			, attributes(begin, begin)
+			, attributeName(begin, begin)
+			, attributeValueStart(begin)
+			, attributeIndex(manager->Resource())
+			, elementStack(manager->Resource())
+			, streamedNames(manager->Resource())
+			, validateUtf8(validation == Utf8::Validation::On)
+			, lines(begin)
+			, input(std::to_address(begin))
+		{
+			Advance();
+		}
+
+		Iterator(Source & source, NameSpaceManager * manager, Utf8::Validation const validation = Utf8::Validation::Off)
+			: manager(manager)
+			, source(&source)
+			, attributeIndex(manager->Resource())
+			, elementStack(manager->Resource())
+			, streamedNames(manager->Resource())
+			, validateUtf8(validation == Utf8::Validation::On)
 		{
+			auto const view = source.Refill({});
+			ptr = view.begin();
+			end = view.end();
+			lastPtr = ptr;
+			elementName = attributes = attributeName = {ptr, ptr};
+			attributeValueStart = ptr;
+			lines = Lines {ptr};
 			Advance();
 		}
 
 		Iterator() = default;
 
+		Iterator(Iterator const & other)
+			: engine(other.engine)
+			, ptr(other.ptr)
+			, end(other.end)
+			, lastPtr(other.lastPtr)
+			, manager(other.manager)
+			, source(other.source)
+			, elementType(other.elementType)
+			, elementName(other.elementName)
+			, attributes(other.attributes)
+			, attributeName(other.attributeName)
+			, attributeValueStart(other.attributeValueStart)
+			, contentClosed(other.contentClosed)
+			, element(other.element)
+			, attributeIndex(other.attributeIndex)
+			, elementStack(other.elementStack, other.elementStack.get_allocator())
+			, streamedNames(other.streamedNames, other.streamedNames.get_allocator())
+			, closedDepth(other.closedDepth)
+			, suspended(other.suspended)
+			, validateUtf8(other.validateUtf8)
+			, utf8(other.utf8)
+			, lines(other.lines)
+			, input(other.input)
+		{
+			element.index.Attach(&attributeIndex);
+			RebaseNames();
+		}
+
+		Iterator & operator=(Iterator const & other)
+		{
+			engine = other.engine;
+			ptr = other.ptr;
+			end = other.end;
+			lastPtr = other.lastPtr;
+			manager = other.manager;
+			source = other.source;
+			elementType = other.elementType;
+			elementName = other.elementName;
+			attributes = other.attributes;
+			attributeName = other.attributeName;
+			attributeValueStart = other.attributeValueStart;
+			contentClosed = other.contentClosed;
+			element = other.element;
+			attributeIndex = other.attributeIndex;
+			elementStack = other.elementStack;
+			streamedNames = other.streamedNames;
+			closedDepth = other.closedDepth;
+			suspended = other.suspended;
+			validateUtf8 = other.validateUtf8;
+			utf8 = other.utf8;
+			lines = other.lines;
+			input = other.input;
+			element.index.Attach(&attributeIndex);
+			RebaseNames();
+			return *this;
+		}
+
+		~Iterator() = default;
+
 		bool operator==(Iterator const & other) const
 		{
 			return lastPtr == other.lastPtr;
@@ -87,6 +190,12 @@ namespace GLib::Xml
 			return *this;
 		}
 
+		// the source ran out of data before the next element, incrementing resumes once it has more
+		[[nodiscard]] bool Suspended() const
+		{
+			return suspended;
+		}
+
 		Element const & operator*() const
 		{
 			return element;
@@ -97,8 +206,127 @@ namespace GLib::Xml
 			return &element;
 		}
 
+		// of the current element, worked out on request
+		[[nodiscard]] Position GetPosition() const
+		{
+			return lines.At(element.offset);
+		}
+
+		// of an earlier element by its Offset, while that input is still buffered
+		[[nodiscard]] Position GetPosition(size_t const offset) const
+		{
+			return lines.At(offset);
+		}
+
+		// on an Open element move to its Close element without producing the elements between
+		// the content is scanned for tags, comments, cdata and processing instructions only to count depth
+		// declarations inside are not pushed, they would be out of scope at the close anyway
+		void SkipSubtree()
+		{
+			if (!lastPtr.has_value() || element.type != ElementType::Open)
+			{
+				return;
+			}
+
+			for (size_t depth = 1;;)
+			{
+				SkipTo(Scanner::Delimiters<1> {'<'});
+				if (StartsWith("<!--"))
+				{
+					SkipPast("-->");
+				}
+				else if (StartsWith("<![CDATA["))
+				{
+					SkipPast("]]>");
+				}
+				else if (StartsWith("<?"))
+				{
+					SkipPast("?>");
+				}
+				else if (StartsWith("</"))
+				{
+					if (--depth == 0)
+					{
+						break; // the close tag is parsed as usual
+					}
+					SkipTag();
+				}
+				else if (!SkipTag())
+				{
+					++depth;
+				}
+			}
+			Advance();
+		}
+
 	private:
-		[[noreturn]] static void IllegalCharacter(char const chr, unsigned int const lineNumber, unsigned int const characterOffset)
+		// stream mode, the open names view the copies
+		void PushName(std::string_view const qName)
+		{
+			if (source == nullptr)
+			{
+				elementStack.push_back(qName);
+				return;
+			}
+
+			char const * const oldBase = streamedNames.data();
+			streamedNames.insert(streamedNames.end(), qName.begin(), qName.end());
+			elementStack.emplace_back(streamedNames.data() + streamedNames.size() - qName.size(), qName.size());
+			if (streamedNames.data() != oldBase)
+			{
+				RebaseNames();
+			}
+		}
+
+		void PopName()
+		{
+			if (source != nullptr)
+			{
+				streamedNames.resize(streamedNames.size() - elementStack.back().size());
+			}
+			elementStack.pop_back();
+		}
+
+		// the copies are contiguous in stack order
+		void RebaseNames()
+		{
+			if (source == nullptr)
+			{
+				return;
+			}
+
+			size_t offset {};
+			for (auto & name : elementStack)
+			{
+				name = {streamedNames.data() + offset, name.size()};
+				offset += name.size();
+			}
+		}
+
+		void AttachElement(std::string_view::const_iterator const start)
+		{
+			attributeIndex.Reset(element.attributes);
+			element.index.Attach(&attributeIndex);
+			element.offset = lines.Offset(start);
+			element.input = input;
+		}
+
+		[[nodiscard]] std::string At(std::string_view::const_iterator const at) const
+		{
+			auto const position = lines.At(at);
+			std::ostringstream stm;
+			if (position.Counted)
+			{
+				stm << "at line: " << position.Line << ", offset: " << position.Column;
+			}
+			else
+			{
+				stm << "at byte: " << position.Offset;
+			}
+			return stm.str();
+		}
+
+		[[noreturn]] void IllegalCharacter(char const chr, std::string_view::const_iterator const at) const
 		{
 			std::ostringstream stm;
 			stm << "Illegal character: ";
@@ -107,12 +335,42 @@ namespace GLib::Xml
 				stm << '\'' << chr << "' ";
 			}
 
-			stm << "(0x" << std::hex << static_cast<unsigned>(chr) << std::dec << ")"
-					<< " at line: " << lineNumber << ", offset: " << characterOffset;
+			stm << "(0x" << std::hex << static_cast<unsigned>(chr) << std::dec << ") " << At(at);
 
 			throw std::runtime_error(stm.str());
 		}
 
+		[[noreturn]] void InvalidUtf8(std::string_view::const_iterator const at) const
+		{
+			std::ostringstream stm;
+			stm << "Invalid UTF-8 byte (0x" << std::hex << static_cast<unsigned>(static_cast<unsigned char>(*at)) << std::dec << ") " << At(at);
+			throw std::runtime_error(stm.str());
+		}
+
+		void CheckUtf8(std::string_view::const_iterator const at)
+		{
+			if (static_cast<unsigned char>(*at) < Detail::continuationMask && utf8 == Utf8::State::Accept)
+			{
+				return;
+			}
+			utf8 = Utf8::Next(utf8, *at);
+			if (utf8 == Utf8::State::Reject)
+			{
+				InvalidUtf8(at);
+			}
+		}
+
+		// a run the scanner skipped
+		void CheckUtf8(char const * const begin, char const * const runEnd)
+		{
+			auto const result = Utf8::Validate(begin, runEnd, utf8);
+			if (result.state == Utf8::State::Reject)
+			{
+				InvalidUtf8(ptr + (result.end - begin));
+			}
+			utf8 = result.state;
+		}
+
 		bool ProcessOldState(std::string_view::const_iterator const oldPtr, State const oldState, State const newState)
 		{
 			if (oldState == State::Text && newState == State::TextEntity)
@@ -123,6 +381,7 @@ namespace GLib::Xml
 			if (oldState == State::Text)
 			{
 				element = {ElementType::Text, Utils::ToStringView({*lastPtr, oldPtr})};
+				AttachElement(*lastPtr);
 				lastPtr = oldPtr;
 				return true;
 			}
@@ -130,6 +389,7 @@ namespace GLib::Xml
 			if (oldState == State::CommentEnd)
 			{
 				element = {ElementType::Comment, Utils::ToStringView({*lastPtr, ptr})};
+				AttachElement(*lastPtr);
 				lastPtr = ptr;
 				return true;
 			}
@@ -161,7 +421,7 @@ namespace GLib::Xml
 			return false;
 		}
 
-		bool ProcessNewState(std::string_view::const_iterator const oldPtr, State const newState)
+		bool ProcessNewState(std::string_view::const_iterator const oldPtr, State const oldState, State const newState)
 		{
 			if (newState == State::AttributeEnd)
 			{
@@ -188,7 +448,7 @@ namespace GLib::Xml
 				return false;
 			}
 
-			if (newState == State::AttributeValue)
+			if (newState == State::AttributeValue && oldState == State::AttributeValueStart) // not on the way back from an entity
 			{
 				attributeValueStart = oldPtr;
 				return false;
@@ -223,11 +483,36 @@ namespace GLib::Xml
 				throw std::runtime_error("++end");
 			}
 
+			if (closedDepth)
+			{
+				manager->Pop(*closedDepth);
+				closedDepth.reset();
+			}
+			suspended = false;
+
 			for (;;)
 			{
-				if (ptr == end)
+				if (ptr == end && YieldCutText())
 				{
+					return;
+				}
+
+				if (ptr == end && !Refill())
+				{
+					if (source != nullptr && !source->Finished())
+					{
+						suspended = true;
+						return;
+					}
+
 					lastPtr.reset();
+					if (validateUtf8 && utf8 != Utf8::State::Accept)
+					{
+						std::ostringstream stm;
+						stm << "Incomplete UTF-8 sequence " << At(ptr);
+						throw std::runtime_error(stm.str());
+					}
+
 					if (!engine.HasRootElement())
 					{
 						throw std::runtime_error("No root element");
@@ -243,20 +528,16 @@ namespace GLib::Xml
 				auto const oldPtr = ptr;
 				auto const oldState = engine.GetState();
 				char const character = *ptr;
-				auto const newState = engine.Push(character);
-
-				if (newState == State::Error)
+				if (validateUtf8)
 				{
-					IllegalCharacter(character, line, pos);
+					CheckUtf8(ptr);
 				}
-				++pos;
+				auto const newState = engine.Push(character);
 
-				if (character == '\n')
+				if (newState == State::Error)
 				{
-					++line;
-					pos = 0;
+					IllegalCharacter(character, ptr);
 				}
-
 				++ptr;
 
 				if (newState != oldState)
@@ -266,14 +547,239 @@ namespace GLib::Xml
 						return;
 					}
 
-					if (ProcessNewState(oldPtr, newState))
+					if (ProcessNewState(oldPtr, oldState, newState))
 					{
 						return;
 					}
 				}
+
+				SkipRun(newState);
+			}
+		}
+
+		// push mode, text cut by the end of the fed bytes is yielded so far, so that a long text node is not carried into the next fragment
+		// an entity or a character cut in two is kept whole for the next text element
+		bool YieldCutText()
+		{
+			auto const state = engine.GetState();
+			if (source == nullptr || source->Finished() || (state != State::Text && state != State::TextEntity))
+			{
+				return false;
+			}
+
+			auto cut = ptr;
+			if (state == State::TextEntity)
+			{
+				while (*--cut != '&')
+				{
+				}
+			}
+			else
+			{
+				cut += Utf8::WholeEnd(std::to_address(*lastPtr), std::to_address(ptr)) - std::to_address(ptr);
+			}
+
+			if (cut == *lastPtr)
+			{
+				return false;
+			}
+
+			element = {ElementType::Text, Utils::ToStringView({*lastPtr, cut})};
+			AttachElement(*lastPtr);
+			lastPtr = cut;
+			return true;
+		}
+
+		// stream mode, move the tail from the last yield to the front of the buffer and read more
+		// returns false at end of input
+		bool Refill()
+		{
+			if (source == nullptr)
+			{
+				return false;
+			}
+
+			auto const keep = *lastPtr;
+			auto const pending = keep == end ? std::string_view {} : Utils::ToStringView({keep, end});
+			lines.Drop(keep);
+			auto const view = source->Refill(pending);
+			lines.Move(view.begin());
+
+			// pointers before the last yield belong to consumed elements and are not read again
+			// all of them point into the old buffer, so comparing with keep is well defined
+			auto const rebase = [&](std::string_view::const_iterator & value)
+			{ value = value < keep ? view.begin() : view.begin() + (value - keep); };
+
+			rebase(ptr);
+			rebase(elementName.first);
+			rebase(elementName.second);
+			rebase(attributes.first);
+			rebase(attributes.second);
+			rebase(attributeName.first);
+			rebase(attributeName.second);
+			rebase(attributeValueStart);
+			lastPtr = view.begin();
+			end = view.end();
+			return view.size() > pending.size();
+		}
+
+		// stream mode may refill, keeping from lastPtr
+		bool Available(size_t const count)
+		{
+			while (static_cast<size_t>(end - ptr) < count)
+			{
+				if (!Refill())
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool StartsWith(std::string_view const value)
+		{
+			return Available(value.size()) && std::equal(value.begin(), value.end(), ptr);
+		}
+
+		void Step()
+		{
+			if (validateUtf8)
+			{
+				CheckUtf8(ptr);
+			}
+			++ptr;
+		}
+
+		// to the next delimiter, refilling in stream mode, the input must not end first
+		template <size_t N>
+		void SkipTo(Scanner::Delimiters<N> const & delimiters)
+		{
+			for (;;)
+			{
+				Skip(delimiters);
+				lastPtr = ptr; // nothing before is read again, a refill can drop it
+				if (ptr != end)
+				{
+					return;
+				}
+				if (!Refill())
+				{
+					ThrowSkipEnd();
+				}
+			}
+		}
+
+		[[noreturn]] void ThrowSkipEnd() const
+		{
+			if (source != nullptr && !source->Finished())
+			{
+				throw std::logic_error("Subtree not complete, a push parser can only skip what has been fed");
+			}
+			throw std::runtime_error("Xml not closed");
+		}
+
+		void SkipPast(std::string_view const terminator)
+		{
+			for (;;)
+			{
+				SkipTo(Scanner::Delimiters<1> {terminator[0]});
+				if (StartsWith(terminator))
+				{
+					for (size_t i = 0; i < terminator.size(); ++i)
+					{
+						Step();
+					}
+					return;
+				}
+				Step();
 			}
 		}
 
+		// past the '>' of the tag at ptr, quoted values may hold '>', returns true for an empty element tag
+		// tags are short so a plain loop beats setting up a vector search
+		bool SkipTag()
+		{
+			Step();
+			bool empty {};
+			for (char quote {};;)
+			{
+				if (ptr == end)
+				{
+					lastPtr = ptr;
+					if (!Refill())
+					{
+						ThrowSkipEnd();
+					}
+					continue;
+				}
+
+				char const character = *ptr;
+				Step();
+				if (quote != 0)
+				{
+					quote = character == quote ? char {} : quote;
+				}
+				else if (character == '>')
+				{
+					return empty;
+				}
+				else
+				{
+					empty = character == '/';
+					quote = character == '"' || character == '\'' ? character : char {};
+				}
+			}
+		}
+
+		// jump over characters that cannot change the state
+		void SkipRun(State const state)
+		{
+			switch (state)
+			{
+				case State::Text:
+				{
+					return Skip(Scanner::Delimiters<2> {'<', '&'});
+				}
+
+				case State::Comment:
+				{
+					return Skip(Scanner::Delimiters<1> {'-'});
+				}
+
+				case State::CDataValue:
+				{
+					return Skip(Scanner::Delimiters<1> {']'});
+				}
+
+				case State::AttributeValue:
+				{
+					return Skip(Scanner::Delimiters<3> {engine.QuoteChar(), '&', '<'});
+				}
+
+				default:
+				{
+					return;
+				}
+			}
+		}
+
+		template <size_t N>
+		void Skip(Scanner::Delimiters<N> const & delimiters)
+		{
+			if (ptr == end)
+			{
+				return;
+			}
+
+			char const * const begin = &*ptr;
+			char const * const runEnd = Scanner::Find(begin, begin + (end - ptr), delimiters);
+			if (validateUtf8)
+			{
+				CheckUtf8(begin, runEnd);
+			}
+			ptr += runEnd - begin;
+		}
+
 		void ProcessElement(std::string_view::const_iterator outerXmlEnd)
 		{
 			if (contentClosed)
@@ -282,7 +788,7 @@ namespace GLib::Xml
 			}
 
 			auto qName = Utils::ToStringView(elementName);
-			auto [name, nameSpace] = manager->Normalise(qName);
+			auto [name, nameSpace] = manager->NormaliseElement(qName);
 
 			element = {qName, name, nameSpace, elementType};
 			element.outerXml = Utils::ToStringView({*lastPtr, outerXmlEnd});
@@ -295,13 +801,14 @@ namespace GLib::Xml
 			{
 				element.attributes = {};
 			}
-			attributes = {};
+			attributes = {ptr, ptr};
+			AttachElement(elementName.first - (element.type == ElementType::Close ? 2 : 1)); // the tag, outerXml starts with any white space before it
 
 			switch (element.type)
 			{
 				case ElementType::Open:
 				{
-					elementStack.push(element.qName);
+					PushName(element.qName);
 					element.depth = elementStack.size();
 					break;
 				}
@@ -309,7 +816,7 @@ namespace GLib::Xml
 				case ElementType::Empty:
 				{
 					element.depth = elementStack.size() + 1;
-					manager->Pop(elementStack.size());
+					closedDepth = elementStack.size();
 					if (element.depth == 1)
 					{
 						contentClosed = true;
@@ -320,19 +827,25 @@ namespace GLib::Xml
 				case ElementType::Close:
 				{
 					element.depth = elementStack.size();
-					auto const & top = elementStack.top();
+					if (elementStack.empty())
+					{
+						std::ostringstream stm;
+						stm << "Element not open: " << element.qName << ", " << At(ptr);
+						throw std::runtime_error(stm.str());
+					}
+					auto const top = elementStack.back();
 					if (element.qName != top)
 					{
 						std::ostringstream stm;
-						stm << "Element mismatch: " << element.qName << " != " << top << ", at line: " << line << ", offset: " << pos;
+						stm << "Element mismatch: " << element.qName << " != " << top << ", " << At(ptr);
 						throw std::runtime_error(stm.str());
 					}
 					if (element.depth == 1)
 					{
 						contentClosed = true;
 					}
-					elementStack.pop();
-					manager->Pop(elementStack.size());
+					PopName();
+					closedDepth = elementStack.size();
 					break;
 				}
 
@@ -348,15 +861,31 @@ namespace GLib::Xml
 	{
 		std::string_view const value;
 		NameSpaceManager manager;
+		Utf8::Validation const validation;
 
 	public:
-		explicit Holder(std::string_view const value)
+		explicit Holder(std::string_view const value, Utf8::Validation const validation = Utf8::Validation::Off)
+			: value(value)
+			, validation(validation)
+		{}
+
+		// working data from resource, which must outlive the holder and its iterators
+		Holder(std::string_view const value, std::pmr::memory_resource * const resource, Utf8::Validation const validation = Utf8::Validation::Off)
+			: value(value)
+			, manager(resource)
+			, validation(validation)
+		{}
+
+		// namespaces declared by an enclosing document
+		Holder(std::string_view const value, NameSpaceManager manager, Utf8::Validation const validation = Utf8::Validation::Off)
 			: value(value)
+			, manager(std::move(manager))
+			, validation(validation)
 		{}
 
 		Iterator begin()
 		{
-			return {value.begin(), value.end(), &manager};
+			return {value.begin(), value.end(), &manager, validation};
 		}
 
 		[[nodiscard]] Iterator end() const
@@ -1,24 +1,122 @@
 #pragma once
 
-#include <stack>
+#include <GLib/Xml/Utils.h>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <memory_resource>
 #include <stdexcept>
-#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/*
+prefix declarations are kept as a flat stack, newest last, searched backwards so redefinitions shadow
+documents rarely have more than a handful in scope so the first few live inline and a linear search beats hashing
+popping a depth truncates the stack, once warmed up there are no allocations
+a value with entities is decoded, into the copied storage or else into a stack of strings of its own, either way it goes when its declaration does
+containers allocate from a memory resource, the iterator uses the same one, so a worker can parse from an arena and release it per document
+*/
 
 namespace GLib::Xml
 {
 	class NameSpaceManager
 	{
 		static constexpr std::string_view xmlNameSpace = "xmlns:";
+		static constexpr std::string_view defaultNameSpace = "xmlns";
+		static constexpr size_t inlineCount = 8;
+
+		struct Declaration
+		{
+			std::string_view prefix; // empty for the default namespace
+			std::string_view value;
+			size_t depth;
+			size_t storageMark;
+			bool decoded; // value is in decodedValues
+		};
 
-		std::unordered_map<std::string_view, std::string_view> nameSpaces;
-		std::stack<std::pair<size_t, std::pair<std::string_view, std::string_view>>> nameSpaceStack;
+		std::array<Declaration, inlineCount> inlineDeclarations {};
+		std::pmr::vector<Declaration> overflow;
+		size_t count {};
+		std::pmr::vector<char> storage; // copied prefixes and values, used as a stack
+		std::pmr::deque<std::pmr::string> decodedValues; // in declaration order, a deque so the values stay put as it grows
+		bool copyValues {};
 
 	public:
+		NameSpaceManager() = default;
+
+		// copy prefixes and values rather than viewing the input, for input that does not outlive the element
+		explicit NameSpaceManager(bool const copyValues, std::pmr::memory_resource * const resource = std::pmr::get_default_resource())
+			: overflow(resource)
+			, storage(resource)
+			, decodedValues(resource)
+			, copyValues(copyValues)
+		{}
+
+		explicit NameSpaceManager(std::pmr::memory_resource * const resource)
+			: NameSpaceManager(false, resource)
+		{}
+
+		// copies allocate from the same resource
+		NameSpaceManager(NameSpaceManager const & other)
+			: inlineDeclarations(other.inlineDeclarations)
+			, overflow(other.overflow, other.Resource())
+			, count(other.count)
+			, storage(other.storage, other.Resource())
+			, decodedValues(other.decodedValues, other.Resource())
+			, copyValues(other.copyValues)
+		{
+			Rebase(other.storage.data());
+			RepointDecoded();
+		}
+
+		NameSpaceManager(NameSpaceManager &&) noexcept = default;
+
+		NameSpaceManager & operator=(NameSpaceManager const & other)
+		{
+			if (this != &other)
+			{
+				*this = NameSpaceManager {other};
+			}
+			return *this;
+		}
+
+		// the resource is not taken over, with a different one the values are copied and copied views rebased
+		NameSpaceManager & operator=(NameSpaceManager && other) // NOLINT(performance-noexcept-move-constructor)
+		{
+			if (this != &other)
+			{
+				char const * const oldBase = other.storage.data();
+				inlineDeclarations = other.inlineDeclarations;
+				overflow = std::move(other.overflow);
+				count = other.count;
+				storage = std::move(other.storage);
+				decodedValues = std::move(other.decodedValues);
+				copyValues = other.copyValues;
+				Rebase(oldBase);
+				RepointDecoded(); // strings from another resource are moved one by one
+			}
+			return *this;
+		}
+		~NameSpaceManager() = default;
+
+		[[nodiscard]] std::pmr::memory_resource * Resource() const
+		{
+			return storage.get_allocator().resource();
+		}
+
 		static bool IsDeclaration(std::string_view const value)
 		{
 			return value.compare(0, xmlNameSpace.size(), xmlNameSpace) == 0;
 		}
 
+		static bool IsDefaultDeclaration(std::string_view const value)
+		{
+			return value == defaultNameSpace;
+		}
+
 		static std::string_view CheckForDeclaration(std::string_view const value)
 		{
 			return IsDeclaration(value) ? value.substr(xmlNameSpace.size()) : std::string_view {};
@@ -26,46 +124,70 @@ namespace GLib::Xml
 
 		[[nodiscard]] std::string_view Get(std::string_view const prefix) const
 		{
-			auto const nit = nameSpaces.find(prefix);
-			if (nit == nameSpaces.end())
+			Declaration const * const declaration = Find(prefix);
+			if (declaration == nullptr)
 			{
 				throw std::runtime_error("Namespace not found"); // +detail
 			}
-			return nit->second;
+			return declaration->value;
 		}
 
 		// rename?
-		void Push(std::string_view const qualifiedName, std::string_view const value, const size_t depth)
+		void Push(std::string_view const qualifiedName, std::string_view value, const size_t depth)
 		{
-			std::string_view const prefix = CheckForDeclaration(qualifiedName);
-			if (prefix.empty())
+			std::string_view prefix;
+			if (!IsDefaultDeclaration(qualifiedName))
 			{
-				return;
+				prefix = CheckForDeclaration(qualifiedName);
+				if (prefix.empty())
+				{
+					return;
+				}
 			}
 
-			auto const nit = nameSpaces.find(prefix);
-			if (nit != nameSpaces.end())
+			// a value with entities is kept decoded, as namespace names are compared by their characters
+			// it is decoded straight into storage from the resource, decoding never lengthens it
+			bool const hasEntities = value.find('&') != std::string_view::npos;
+			bool decoded {};
+			size_t const storageMark = storage.size();
+			if (copyValues)
 			{
-				nameSpaceStack.push({depth, {prefix, nit->second}});
-				nit->second = value;
+				Reserve(prefix.size() + value.size());
+				prefix = Store(prefix);
+				value = hasEntities ? StoreDecoded(value) : Store(value);
+			}
+			else if (hasEntities)
+			{
+				value = PushDecoded(value);
+				decoded = true;
+			}
+
+			Declaration const declaration {prefix, value, depth, storageMark, decoded};
+			if (count < inlineCount)
+			{
+				inlineDeclarations[count] = declaration;
 			}
 			else
 			{
-				nameSpaces.emplace(prefix, value);
+				overflow.push_back(declaration);
 			}
+			++count;
 		}
 
+		// undo declarations made at depth, uncovering any they redefined
 		void Pop(size_t const depth)
 		{
-			while (!nameSpaceStack.empty() && depth == nameSpaceStack.top().first)
+			while (count != 0 && At(count - 1).depth == depth)
 			{
-				auto nit = nameSpaces.find(nameSpaceStack.top().second.first);
-				if (nit == nameSpaces.end())
+				storage.resize(At(count - 1).storageMark);
+				if (At(count - 1).decoded)
+				{
+					decodedValues.pop_back();
+				}
+				if (--count >= inlineCount)
 				{
-					throw std::logic_error("Inconsistent namespace stack");
+					overflow.pop_back();
 				}
-				nit->second = nameSpaceStack.top().second.second;
-				nameSpaceStack.pop();
 			}
 		}
 
@@ -77,6 +199,7 @@ namespace GLib::Xml
 			}
 		}
 
+		// attribute names, an unprefixed name has no namespace
 		[[nodiscard]] std::tuple<std::string_view, std::string_view> Normalise(std::string_view const name) const
 		{
 			size_t const colon = name.find(':');
@@ -84,14 +207,135 @@ namespace GLib::Xml
 			{
 				ValidateName(colon, name);
 				auto const prefix = name.substr(0, colon);
-				auto const iter = nameSpaces.find(prefix);
-				if (iter == nameSpaces.end())
+				Declaration const * const declaration = Find(prefix);
+				if (declaration == nullptr)
 				{
 					throw std::runtime_error(std::string("NameSpace ") + std::string(prefix) + " not found");
 				}
-				return {name.substr(colon + 1), iter->second};
+				return {name.substr(colon + 1), declaration->value};
 			}
 			return {name, {}};
 		}
+
+		// element names, an unprefixed name is in the default namespace if one is declared
+		[[nodiscard]] std::tuple<std::string_view, std::string_view> NormaliseElement(std::string_view const name) const
+		{
+			if (name.find(':') == std::string_view::npos)
+			{
+				Declaration const * const declaration = Find({});
+				return {name, declaration != nullptr ? declaration->value : std::string_view {}};
+			}
+			return Normalise(name);
+		}
+
+	private:
+		[[nodiscard]] Declaration const & At(size_t const index) const
+		{
+			return index < inlineCount ? inlineDeclarations[index] : overflow[index - inlineCount];
+		}
+
+		[[nodiscard]] Declaration & At(size_t const index)
+		{
+			return index < inlineCount ? inlineDeclarations[index] : overflow[index - inlineCount];
+		}
+
+		[[nodiscard]] Declaration const * Find(std::string_view const prefix) const
+		{
+			for (size_t index = count; index-- != 0;)
+			{
+				if (Declaration const & declaration = At(index); declaration.prefix == prefix)
+				{
+					return &declaration;
+				}
+			}
+			return nullptr;
+		}
+
+		void Reserve(size_t const size)
+		{
+			if (storage.capacity() - storage.size() < size)
+			{
+				constexpr size_t minimumCapacity = 256;
+				char const * const oldBase = storage.data();
+				storage.reserve(std::max({storage.capacity() * 2, storage.size() + size, minimumCapacity}));
+				Rebase(oldBase);
+			}
+		}
+
+		// capacity is already reserved
+		std::string_view Store(std::string_view const value)
+		{
+			if (value.empty())
+			{
+				return {};
+			}
+
+			size_t const offset = storage.size();
+			storage.insert(storage.end(), value.begin(), value.end());
+			return {storage.data() + offset, value.size()};
+		}
+
+		// capacity is already reserved
+		std::string_view StoreDecoded(std::string_view const value)
+		{
+			size_t const offset = storage.size();
+			storage.resize(offset + value.size());
+			char * const begin = storage.data() + offset;
+			storage.resize(offset + static_cast<size_t>(Utils::DecodeTo(value, begin) - begin));
+			return {begin, storage.size() - offset};
+		}
+
+		// a value that fails to decode is not kept, decodedValues pairs with the decoded declarations
+		std::string_view PushDecoded(std::string_view const value)
+		{
+			std::pmr::string & decodedValue = decodedValues.emplace_back(value.size(), '\0');
+			try
+			{
+				decodedValue.resize(static_cast<size_t>(Utils::DecodeTo(value, decodedValue.data()) - decodedValue.data()));
+			}
+			catch (...)
+			{
+				decodedValues.pop_back();
+				throw;
+			}
+			return decodedValue;
+		}
+
+		// decoded values are in declaration order
+		void RepointDecoded()
+		{
+			auto value = decodedValues.begin();
+			for (size_t index = 0; index != count; ++index)
+			{
+				if (Declaration & declaration = At(index); declaration.decoded)
+				{
+					declaration.value = *value++;
+				}
+			}
+		}
+
+		// copied views follow the storage when it moves
+		void Rebase(char const * const oldBase)
+		{
+			if (!copyValues || oldBase == storage.data())
+			{
+				return;
+			}
+
+			auto const rebase = [&](std::string_view & value)
+			{
+				if (!value.empty())
+				{
+					value = {storage.data() + (value.data() - oldBase), value.size()};
+				}
+			};
+
+			for (size_t index = 0; index != count; ++index)
+			{
+				Declaration & declaration = At(index);
+				rebase(declaration.prefix);
+				rebase(declaration.value);
+			}
+		}
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <GLib/ParallelFor.h>
+#include <GLib/Xml/Iterator.h>
+
+#include <exception>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+Reuse for many small documents, such as messages from a bus
+a Parser keeps a pool of the memory its holders used, each holder takes its working data from the pool and gives it back when it goes
+so once warmed up a document makes no heap calls, the pool grows to what the largest document needed
+not thread safe, ParseBatch gives each of its threads a parser of its own
+*/
+
+namespace GLib::Xml
+{
+	class Parser
+	{
+		std::pmr::unsynchronized_pool_resource pool;
+
+	public:
+		explicit Parser(std::pmr::memory_resource * const upstream = std::pmr::get_default_resource())
+			: pool(upstream)
+		{}
+
+		Parser(Parser const &) = delete;
+		Parser(Parser &&) = delete;
+		Parser & operator=(Parser const &) = delete;
+		Parser & operator=(Parser &&) = delete;
+		~Parser() = default;
+
+		// the holder must not outlive the parser
+		[[nodiscard]] Holder Parse(std::string_view const value, Utf8::Validation const validation = Utf8::Validation::Off)
+		{
+			return Holder {value, &pool, validation};
+		}
+
+		// gives the pool's memory back upstream, no holder may be in use
+		void Release()
+		{
+			pool.release();
+		}
+	};
+
+	template <typename Result>
+	struct BatchResult
+	{
+		std::optional<Result> Value;
+		std::string Error; // what() of the exception if the document or the function failed
+
+		[[nodiscard]] bool Ok() const
+		{
+			return Value.has_value();
+		}
+	};
+
+	// returns function(Holder &) for each document in order, using up to threads threads, zero for the hardware concurrency
+	// a std::exception from parsing or the function fails only that document, results must not view decoded namespace values
+	template <typename Function>
+	auto ParseBatch(std::span<std::string_view const> const documents, Function const & function, size_t const threads = 0)
+	{
+		using Result = std::invoke_result_t<Function const &, Holder &>;
+
+		std::vector<BatchResult<Result>> results(documents.size());
+		std::vector<std::optional<Parser>> parsers(ThreadCount(documents.size(), threads));
+		ParallelForWorkers(documents.size(),
+											 threads,
+											 [&](size_t const worker, size_t const index)
+											 {
+												 auto & parser = parsers[worker].has_value() ? *parsers[worker] : parsers[worker].emplace();
+												 try
+												 {
+													 auto holder = parser.Parse(documents[index]);
+													 results[index].Value.emplace(function(holder));
+												 }
+												 catch (std::exception const & e)
+												 {
+													 results[index].Error = e.what();
+												 }
+											 });
+		return results;
+	}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <GLib/Xml/Scanner.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+/*
+line and column are worked out from byte offsets only when asked for, by an error or a caller, the parse loop does not track them
+newlines are counted with the scanner from a cursor that moves forward with the requests, so asking once per element stays linear
+in stream mode a refill drops the consumed input without scanning it, only its length is kept
+once a position has been asked for, the newlines of dropped input are counted first so that later positions stay exact
+input dropped before that is not counted, from then on only the byte offset is known
+*/
+
+namespace GLib::Xml
+{
+	// zero based, Column counts bytes from the start of the line
+	struct Position
+	{
+		size_t Line;
+		size_t Column;
+		size_t Offset;
+		bool Counted {true}; // false when streamed input was dropped uncounted, only Offset is set
+	};
+
+	// offset in input held in full, counted from its start on each call, for a one off lookup
+	[[nodiscard]] inline Position PositionOf(char const * const input, size_t const offset)
+	{
+		auto const run = Scanner::Skip(input, input + offset, Scanner::Delimiters<0> {});
+		size_t const lineStart = run.newLines == 0 ? 0 : static_cast<size_t>(run.lastNewLine - input) + 1;
+		return {run.newLines, offset - lineStart, offset};
+	}
+
+	class Lines
+	{
+		using Ptr = std::string_view::const_iterator;
+
+		struct Cursor
+		{
+			Ptr at;
+			size_t line;
+			size_t lineStart; // offset
+		};
+
+		Ptr begin {};
+		size_t beginOffset {};
+		Cursor base {};						// at begin
+		mutable Cursor cursor {}; // the last position asked for
+		mutable bool tracking {}; // a position was asked for, dropped input is counted from then on
+		bool counted {true};			// no input was dropped uncounted
+
+	public:
+		Lines() = default;
+
+		explicit Lines(Ptr const begin)
+			: begin(begin)
+			, base {begin, 0, 0}
+			, cursor(base)
+		{}
+
+		// the input before keep is about to be dropped
+		void Drop(Ptr const keep)
+		{
+			if (keep == begin)
+			{
+				return;
+			}
+
+			if (counted && tracking)
+			{
+				static_cast<void>(At(keep));
+			}
+			else
+			{
+				counted = false;
+				cursor = {keep, 0, 0};
+			}
+			beginOffset = Offset(keep);
+			begin = keep;
+			base = cursor;
+		}
+
+		// the kept input has moved to newBegin
+		void Move(Ptr const newBegin)
+		{
+			begin = base.at = cursor.at = newBegin;
+		}
+
+		[[nodiscard]] size_t Offset(Ptr const ptr) const
+		{
+			return beginOffset + static_cast<size_t>(ptr - begin);
+		}
+
+		// ptr is in the current buffer
+		[[nodiscard]] Position At(Ptr const ptr) const
+		{
+			tracking = true;
+			if (!counted)
+			{
+				return {0, 0, Offset(ptr), false};
+			}
+
+			if (ptr < cursor.at)
+			{
+				cursor = base;
+			}
+
+			auto const run = Scanner::Skip(std::to_address(cursor.at), std::to_address(ptr), Scanner::Delimiters<0> {});
+			if (run.newLines != 0)
+			{
+				cursor.line += run.newLines;
+				cursor.lineStart = beginOffset + static_cast<size_t>(run.lastNewLine - std::to_address(begin)) + 1;
+			}
+			cursor.at = ptr;
+
+			size_t const offset = Offset(ptr);
+			return {cursor.line, offset - cursor.lineStart, offset};
+		}
+
+		[[nodiscard]] Position At(size_t const offset) const
+		{
+			if (offset < beginOffset)
+			{
+				throw std::logic_error("Position no longer buffered");
+			}
+			return At(begin + static_cast<std::ptrdiff_t>(offset - beginOffset));
+		}
+	};
+}
@@ -2,53 +2,99 @@
 
 #include <GLib/Xml/Utils.h>
 
-#include <iomanip>
-#include <sstream>
-#include <stack>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+output goes straight to a sink as views, the default sink appends to a string that Release hands over without a copy
+open element names are kept back to back in one string with their start offsets, so a warmed up printer does not allocate
+indentation is written from a constant table of spaces
+*/
 
 namespace GLib::Xml
 {
-	class Printer
+	// the default sink, a growable buffer
+	class StringSink
+	{
+		std::string value;
+
+	public:
+		void operator()(std::string_view const data)
+		{
+			value.append(data);
+		}
+
+		[[nodiscard]] std::string const & Value() const
+		{
+			return value;
+		}
+
+		[[nodiscard]] std::string Release()
+		{
+			return std::exchange(value, {});
+		}
+	};
+
+	// Sink is called with each piece of output as a std::string_view
+	template <typename Sink>
+	class BasicPrinter
 	{
 		static constexpr int textDepthNotSet = -1;
+		static constexpr std::string_view spaces = "                                                                ";
+		static constexpr std::string_view newLine = "\n";
 
+		Sink sink;
 		bool const format;
 		bool elementOpen {};
 		bool isFirstElement {true};
 		int depth {};
 		int textDepth;
-		std::ostringstream stm;
-		std::stack<std::string> stack;
+		std::string names;
+		std::vector<size_t> nameStarts;
 
 	public:
-		explicit Printer(bool const format = true)
-			: format(format)
+		explicit BasicPrinter(bool const format = true)
+			: BasicPrinter(Sink {}, format)
+		{}
+
+		explicit BasicPrinter(Sink sink, bool const format = true)
+			: sink(std::move(sink))
+			, format(format)
 			, textDepth(textDepthNotSet)
 		{}
 
 		void PushDeclaration()
 		{
-			stm << R"(<?xml version="1.0" encoding="UTF-8" ?>)" << std::endl;
+			Write(R"(<?xml version="1.0" encoding="UTF-8" ?>)");
+			Write(newLine);
 		}
 
-		void OpenElement(std::string const & name)
+		void OpenElement(std::string_view const name)
 		{
 			OpenElement(name, format);
 		}
 
-		void OpenElement(std::string const & name, bool const elementFormat)
+		void OpenElement(std::string_view const name, bool const elementFormat)
 		{
 			CloseJustOpenedElement();
-			stack.push(name);
+			nameStarts.push_back(names.size());
+			names.append(name);
 			if (textDepth == textDepthNotSet && !isFirstElement && elementFormat)
 			{
-				stm << std::endl;
+				Write(newLine);
 			}
 			if (elementFormat)
 			{
-				stm << std::string(depth, ' ');
+				Indent(depth);
 			}
-			stm << '<' << name;
+			Write("<");
+			Write(name);
 			elementOpen = true;
 			isFirstElement = false;
 			++depth;
@@ -57,14 +103,18 @@ namespace GLib::Xml
 		void PushAttribute(std::string_view const name, std::string_view const value)
 		{
 			AssertTrue(elementOpen, "Element not open");
-			stm << ' ' << name << R"(=")";
+			Write(" ");
+			Write(name);
+			Write(R"(=")");
 			Text(value);
-			stm << '"';
+			Write(R"(")");
 		}
 
 		void PushAttribute(std::string_view const name, const int64_t value)
 		{
-			PushAttribute(name, std::to_string(value).c_str());
+			std::array<char, std::numeric_limits<int64_t>::digits10 + 2> buffer {};
+			auto const result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+			PushAttribute(name, std::string_view {buffer.data(), static_cast<size_t>(result.ptr - buffer.data())});
 		}
 
 		void PushText(std::string_view const text)
@@ -76,7 +126,10 @@ namespace GLib::Xml
 
 		void PushDocType(std::string_view const docType)
 		{
-			stm << "<!DOCTYPE " << docType << '>' << std::endl;
+			Write("<!DOCTYPE ");
+			Write(docType);
+			Write(">");
+			Write(newLine);
 		}
 
 		void CloseElement()
@@ -87,20 +140,23 @@ namespace GLib::Xml
 		void CloseElement(bool const elementFormat)
 		{
 			--depth;
-			auto const name = stack.top();
-			stack.pop();
 			if (elementOpen)
 			{
-				stm << "/>";
+				Write("/>");
 			}
 			else
 			{
 				if (textDepth == textDepthNotSet && elementFormat)
 				{
-					stm << std::endl << std::setw(depth) << "";
+					Write(newLine);
+					Indent(depth);
 				}
-				stm << "</" << name << '>';
+				Write("</");
+				Write(TopName());
+				Write(">");
 			}
+			names.resize(nameStarts.back());
+			nameStarts.pop_back();
 
 			if (textDepth == depth)
 			{
@@ -109,7 +165,7 @@ namespace GLib::Xml
 
 			if (depth == 0 && elementFormat)
 			{
-				stm << std::endl;
+				Write(newLine);
 			}
 
 			elementOpen = false;
@@ -117,34 +173,72 @@ namespace GLib::Xml
 
 		void Close()
 		{
-			while (!stack.empty())
+			while (!nameStarts.empty())
 			{
 				CloseElement();
 			}
 		}
 
+		// for the string sink
 		[[nodiscard]] std::string Xml() const
 		{
-			if (depth != 0)
+			AssertClosed();
+			return sink.Value();
+		}
+
+		// for the string sink, hands over the output, the printer is left empty
+		[[nodiscard]] std::string Release()
+		{
+			AssertClosed();
+			return sink.Release();
+		}
+
+		[[nodiscard]] Sink & GetSink()
+		{
+			return sink;
+		}
+
+	private:
+		[[nodiscard]] std::string_view TopName() const
+		{
+			return std::string_view {names}.substr(nameStarts.back());
+		}
+
+		void Write(std::string_view const value)
+		{
+			sink(value);
+		}
+
+		void Indent(int const count)
+		{
+			auto remaining = static_cast<size_t>(std::max(count, 0));
+			for (; remaining > spaces.size(); remaining -= spaces.size())
 			{
-				throw std::runtime_error("Element is not closed: " + stack.top());
+				Write(spaces);
 			}
-			return stm.str();
+			Write(spaces.substr(0, remaining));
 		}
 
-	private:
 		void CloseJustOpenedElement()
 		{
 			if (elementOpen)
 			{
-				stm << '>';
+				Write(">");
 				elementOpen = false;
 			}
 		}
 
 		void Text(std::string_view const value)
 		{
-			Utils::Escape(value, stm);
+			Utils::EscapeTo(value, [&](char const * const data, size_t const size) { Write({data, size}); });
+		}
+
+		void AssertClosed() const
+		{
+			if (depth != 0)
+			{
+				throw std::runtime_error("Element is not closed: " + std::string(TopName()));
+			}
 		}
 
 		static void AssertTrue(bool const value, char const * message)
@@ -155,4 +249,6 @@ namespace GLib::Xml
 			}
 		}
 	};
-}
\ No newline at end of file
+
+	using Printer = BasicPrinter<StringSink>;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Source.h>
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+/*
+Push mode, for input that arrives in fragments such as socket reads
+each Feed parses what it can straight from the fed bytes, an element cut by the end of a fragment suspends the iterator
+only that incomplete tail is copied into a carry buffer, joined with just enough of the next fragment to complete it
+text cut by a fragment is yielded as far as it goes, so a text node may come as more than one Text element and is never carried
+element views, including namespace values, are valid until the next increment and the fed bytes must outlive the batch
+*/
+
+namespace GLib::Xml
+{
+	class PushSource : public Source
+	{
+		static constexpr size_t minimumJoin = 64;
+
+		std::string_view input;
+		std::vector<char> carry;
+		bool lastFromCarry {};
+		bool finished {};
+
+	public:
+		// the bytes are read in place until the next Push
+		void Push(std::string_view const bytes)
+		{
+			input = bytes;
+		}
+
+		void Finish()
+		{
+			finished = true;
+		}
+
+		[[nodiscard]] bool Finished() const override
+		{
+			return finished;
+		}
+
+		[[nodiscard]] size_t CarryCapacity() const
+		{
+			return carry.capacity();
+		}
+
+		std::string_view Refill(std::string_view const pending) override
+		{
+			if (input.empty())
+			{
+				// out of data, a tail still in the fed bytes must outlive them
+				if (!pending.empty() && !lastFromCarry)
+				{
+					carry.assign(pending.begin(), pending.end());
+					return FromCarry();
+				}
+				return pending;
+			}
+
+			if (pending.empty())
+			{
+				lastFromCarry = false;
+				return std::exchange(input, {});
+			}
+
+			// the tail continues in the new bytes, join up to the next tag or entity boundary, refilled again if that is not enough
+			if (lastFromCarry)
+			{
+				std::memmove(carry.data(), pending.data(), pending.size());
+				carry.resize(pending.size());
+			}
+			else
+			{
+				carry.assign(pending.begin(), pending.end());
+			}
+			// no more than is already carried either, so a long tail is joined in doubling steps and a cut character in a few bytes
+			size_t const boundary = input.find_first_of("<>;");
+			size_t const take = std::min(boundary == std::string_view::npos ? input.size() : boundary + 1, std::max(pending.size(), minimumJoin));
+			carry.insert(carry.end(), input.begin(), input.begin() + static_cast<std::ptrdiff_t>(take));
+			input.remove_prefix(take);
+			return FromCarry();
+		}
+
+	private:
+		std::string_view FromCarry()
+		{
+			lastFromCarry = true;
+			return {carry.data(), carry.size()};
+		}
+	};
+
+	class PushParser
+	{
+		PushSource source;
+		NameSpaceManager manager {true};
+		std::optional<Iterator> iterator;
+		Utf8::Validation const validation;
+
+	public:
+		// the elements completed by one Feed, iterate them all before the next Feed
+		class Batch
+		{
+			Iterator * iterator;
+
+		public:
+			class Cursor
+			{
+				Iterator * iterator;
+
+			public:
+				explicit Cursor(Iterator * const iterator)
+					: iterator(iterator)
+				{}
+
+				bool operator==(Cursor const & /*end*/) const
+				{
+					return iterator == nullptr || iterator->Suspended() || *iterator == Iterator {};
+				}
+
+				bool operator!=(Cursor const & other) const
+				{
+					return !(*this == other);
+				}
+
+				Cursor & operator++()
+				{
+					++*iterator;
+					return *this;
+				}
+
+				Element const & operator*() const
+				{
+					return **iterator;
+				}
+
+				Element const * operator->() const
+				{
+					return &**iterator;
+				}
+
+				[[nodiscard]] Position GetPosition() const
+				{
+					return iterator->GetPosition();
+				}
+			};
+
+			explicit Batch(Iterator * const iterator)
+				: iterator(iterator)
+			{}
+
+			[[nodiscard]] Cursor begin() const
+			{
+				return Cursor {iterator};
+			}
+
+			[[nodiscard]] Cursor end() const
+			{
+				static_cast<void>(this);
+				return Cursor {nullptr};
+			}
+		};
+
+		explicit PushParser(Utf8::Validation const validation = Utf8::Validation::Off)
+			: validation(validation)
+		{}
+
+		PushParser(PushParser const &) = delete;
+		PushParser(PushParser &&) = delete;
+		PushParser & operator=(PushParser const &) = delete;
+		PushParser & operator=(PushParser &&) = delete;
+		~PushParser() = default;
+
+		// bytes must stay valid while the batch is iterated
+		Batch Feed(std::string_view const bytes)
+		{
+			if (iterator && !iterator->Suspended())
+			{
+				throw std::logic_error("Elements of the previous feed not consumed");
+			}
+
+			source.Push(bytes);
+			if (bytes.empty())
+			{
+				return Batch {nullptr};
+			}
+
+			if (iterator)
+			{
+				++*iterator;
+			}
+			else
+			{
+				iterator.emplace(source, &manager, validation);
+			}
+			return Batch {&*iterator};
+		}
+
+		// end of input, throws if the document is incomplete
+		void Finish()
+		{
+			if (iterator && !iterator->Suspended())
+			{
+				throw std::logic_error("Elements of the previous feed not consumed");
+			}
+
+			source.Finish();
+			if (!iterator)
+			{
+				throw std::runtime_error("No root element");
+			}
+			for (++*iterator; *iterator != Iterator {}; ++*iterator)
+			{
+				// an element can only complete with a fed character, nothing is left to produce
+			}
+		}
+
+		[[nodiscard]] size_t CarryCapacity() const
+		{
+			return source.CarryCapacity();
+		}
+	};
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <GLib/Xml/Iterator.h>
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+Compiled subset of XPath evaluated over the Element stream in one forward pass, no tree is built
+	/a/b       child steps
+	//b        descendant steps, a/b//c
+	p:b p:* *  name tests, prefixes are bound by the caller, unprefixed names have no namespace as in XPath
+	b[@x]      attribute present, b[@x='v'] or b[@x="v"] attribute value, values are compared decoded
+	/a/@x      a final attribute step selects attributes instead of elements, /a/@* selects all of them
+
+the state is a set of matched step counts per open element, a bit set since a descendant step can match at several depths
+an element whose set is empty cannot contain a match, its subtree is passed over without evaluation
+with an Xml::Iterator the subtree is skipped by Iterator::SkipSubtree, so its content is only checked for balance
+*/
+
+namespace GLib::Xml
+{
+	class Query
+	{
+	public:
+		using NameSpaces = std::vector<std::pair<std::string, std::string>>;
+
+	private:
+		using StepSet = uint64_t;
+		static constexpr size_t maximumSteps = std::numeric_limits<StepSet>::digits - 1;
+
+		enum class Axis : uint8_t
+		{
+			Child,
+			Descendant
+		};
+
+		struct NameTest
+		{
+			std::string name;
+			std::string nameSpace;
+			bool anyName {};
+			bool anyNameSpace {};
+
+			[[nodiscard]] bool Matches(std::string_view const localName, std::string_view const localNameSpace) const
+			{
+				return (anyName || name == localName) && (anyNameSpace || nameSpace == localNameSpace);
+			}
+		};
+
+		struct Predicate
+		{
+			NameTest test;
+			std::optional<std::string> value;
+		};
+
+		struct Step
+		{
+			Axis axis {};
+			NameTest test;
+			std::vector<Predicate> predicates;
+		};
+
+		std::vector<Step> steps;
+		std::optional<NameTest> attribute;
+
+	public:
+		explicit Query(std::string_view const path, NameSpaces const & nameSpaces = {})
+		{
+			Parser {path, nameSpaces, *this}.Parse();
+		}
+
+		// calls function(element, attribute) for each match in document order
+		// attribute is nullptr unless the query selects attributes, both are only valid during the call
+		template <typename Elements, typename Function>
+		void Run(Elements && elements, Function const & function) const
+		{
+			StepSet const matched = StepSet {1} << steps.size();
+			std::vector<StepSet> stack {1}; // nothing matched above the root
+			size_t skipDepth {};
+			std::string buffer;
+
+			for (auto it = elements.begin(), end = elements.end(); it != end; ++it)
+			{
+				auto const & element = *it;
+				switch (element.Type())
+				{
+					case ElementType::Open:
+					case ElementType::Empty:
+					{
+						if (skipDepth != 0)
+						{
+							skipDepth += element.Type() == ElementType::Open ? 1 : 0;
+							break;
+						}
+
+						StepSet const next = Advance(stack.back(), element, buffer);
+						if ((next & matched) != 0)
+						{
+							Report(element, function);
+						}
+						if (element.Type() == ElementType::Open)
+						{
+							if ((next & ~matched) == 0)
+							{
+								if constexpr (requires { it.SkipSubtree(); })
+								{
+									it.SkipSubtree(); // on to the close, which the next increment passes
+								}
+								else
+								{
+									skipDepth = 1;
+								}
+							}
+							else
+							{
+								stack.push_back(next & ~matched);
+							}
+						}
+						break;
+					}
+
+					case ElementType::Close:
+						if (skipDepth != 0)
+						{
+							--skipDepth;
+						}
+						else
+						{
+							stack.pop_back();
+						}
+						break;
+
+					default:
+						break;
+				}
+			}
+		}
+
+		template <typename Function>
+		void Run(std::string_view const xml, Function const & function) const
+		{
+			Run(Holder {xml}, function);
+		}
+
+	private:
+		StepSet Advance(StepSet const current, Element const & element, std::string & buffer) const
+		{
+			StepSet next {};
+			for (StepSet remaining = current; remaining != 0; remaining &= remaining - 1)
+			{
+				auto const index = static_cast<size_t>(std::countr_zero(remaining));
+				Step const & step = steps[index];
+				if (step.axis == Axis::Descendant)
+				{
+					next |= StepSet {1} << index;
+				}
+				if (Matches(step, element, buffer))
+				{
+					next |= StepSet {1} << (index + 1);
+				}
+			}
+			return next;
+		}
+
+		static bool Matches(Step const & step, Element const & element, std::string & buffer)
+		{
+			if (!step.test.Matches(element.Name(), element.NameSpace()))
+			{
+				return false;
+			}
+
+			for (Predicate const & predicate : step.predicates)
+			{
+				bool found {};
+				for (auto const & attribute : element.GetAttributes())
+				{
+					if (predicate.test.Matches(attribute.Name, attribute.NameSpace) &&
+							(!predicate.value || attribute.DecodedValue(buffer) == *predicate.value))
+					{
+						found = true;
+						break;
+					}
+				}
+				if (!found)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template <typename Function>
+		void Report(Element const & element, Function const & function) const
+		{
+			if (!attribute)
+			{
+				function(element, static_cast<Attribute const *>(nullptr));
+				return;
+			}
+
+			for (auto const & value : element.GetAttributes())
+			{
+				if (attribute->Matches(value.Name, value.NameSpace))
+				{
+					function(element, &value);
+				}
+			}
+		}
+
+		class Parser
+		{
+			std::string_view const path;
+			NameSpaces const & nameSpaces;
+			Query & query;
+			size_t pos {};
+
+		public:
+			Parser(std::string_view const path, NameSpaces const & nameSpaces, Query & query)
+				: path(path)
+				, nameSpaces(nameSpaces)
+				, query(query)
+			{}
+
+			void Parse()
+			{
+				if (path.empty() || path[0] != '/')
+				{
+					Fail("path must start with '/'");
+				}
+
+				while (pos != path.size())
+				{
+					Expect('/');
+					Axis const axis = Accept('/') ? Axis::Descendant : Axis::Child;
+
+					if (Accept('@'))
+					{
+						if (axis == Axis::Descendant)
+						{
+							Fail("descendant attribute steps are not supported");
+						}
+						query.attribute = ParseNameTest("/[");
+						if (pos != path.size())
+						{
+							Fail("attribute step must be last");
+						}
+						break;
+					}
+
+					Step & step = query.steps.emplace_back(Step {axis, ParseNameTest("/["), {}});
+					while (Accept('['))
+					{
+						step.predicates.push_back(ParsePredicate());
+					}
+				}
+
+				if (query.steps.empty())
+				{
+					Fail("no element steps");
+				}
+				if (query.steps.size() > maximumSteps)
+				{
+					Fail("too many steps");
+				}
+			}
+
+		private:
+			Predicate ParsePredicate()
+			{
+				Expect('@');
+				Predicate predicate {ParseNameTest("=]"), {}};
+				if (Accept('='))
+				{
+					if (pos == path.size() || (path[pos] != '\'' && path[pos] != '"'))
+					{
+						Fail("expected quoted value");
+					}
+					char const quote = path[pos++];
+					size_t const end = path.find(quote, pos);
+					if (end == std::string_view::npos)
+					{
+						Fail("unterminated value");
+					}
+					predicate.value = path.substr(pos, end - pos);
+					pos = end + 1;
+				}
+				Expect(']');
+				return predicate;
+			}
+
+			NameTest ParseNameTest(std::string_view const delimiters)
+			{
+				size_t const end = std::min(path.find_first_of(delimiters, pos), path.size());
+				std::string_view const qName = path.substr(pos, end - pos);
+				pos = end;
+
+				NameTest test;
+				size_t const colon = qName.find(':');
+				std::string_view const name = colon == std::string_view::npos ? qName : qName.substr(colon + 1);
+				if (name.empty() || colon == 0 || name.find(':') != std::string_view::npos)
+				{
+					Fail("invalid name '" + std::string(qName) + '\'');
+				}
+
+				test.anyName = name == "*";
+				test.name = name;
+				if (colon == std::string_view::npos)
+				{
+					test.anyNameSpace = test.anyName;
+				}
+				else
+				{
+					test.nameSpace = Resolve(qName.substr(0, colon));
+				}
+				return test;
+			}
+
+			std::string Resolve(std::string_view const prefix) const
+			{
+				for (auto const & [name, value] : nameSpaces)
+				{
+					if (name == prefix)
+					{
+						return value;
+					}
+				}
+				Fail("unknown prefix '" + std::string(prefix) + '\'');
+			}
+
+			bool Accept(char const value)
+			{
+				if (pos != path.size() && path[pos] == value)
+				{
+					++pos;
+					return true;
+				}
+				return false;
+			}
+
+			void Expect(char const value)
+			{
+				if (!Accept(value))
+				{
+					Fail(std::string("expected '") + value + '\'');
+				}
+			}
+
+			[[noreturn]] void Fail(std::string const & message) const
+			{
+				throw std::runtime_error("Invalid query: " + message + ", at offset: " + std::to_string(pos));
+			}
+		};
+	};
+}
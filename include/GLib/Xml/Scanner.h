@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GLIB_XML_SCANNER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLIB_XML_SCANNER_SSE2
+#endif
+
+/*
+Vectorised search for the next significant character in runs of text, comments, cdata and attribute values
+AVX2 when compiled in, else SSE2 on x86\x64, else scalar
+Skip counts newlines in the same pass, with no delimiters it counts the lines of a range for positions on request
+*/
+
+namespace GLib::Xml::Scanner
+{
+	inline constexpr char NewLine = '\n';
+
+	template <size_t N>
+	using Delimiters = std::array<char, N>;
+
+	struct Run
+	{
+		char const * end;
+		unsigned int newLines;
+		char const * lastNewLine;
+	};
+
+	namespace Detail
+	{
+		template <size_t N>
+		bool IsDelimiter(char const chr, Delimiters<N> const & delimiters)
+		{
+			for (char const delimiter : delimiters)
+			{
+				if (chr == delimiter)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template <size_t N>
+		Run SkipScalar(char const * ptr, char const * const end, Delimiters<N> const & delimiters, Run run)
+		{
+			for (; ptr != end && !IsDelimiter(*ptr, delimiters); ++ptr)
+			{
+				if (*ptr == NewLine)
+				{
+					++run.newLines;
+					run.lastNewLine = ptr;
+				}
+			}
+			run.end = ptr;
+			return run;
+		}
+
+		template <size_t N>
+		char const * FindScalar(char const * ptr, char const * const end, Delimiters<N> const & delimiters)
+		{
+			while (ptr != end && !IsDelimiter(*ptr, delimiters))
+			{
+				++ptr;
+			}
+			return ptr;
+		}
+
+		template <typename Mask>
+		void CountNewLines(char const * const block, Mask newLineMask, Run & run)
+		{
+			if (newLineMask != 0)
+			{
+				run.newLines += static_cast<unsigned int>(std::popcount(newLineMask));
+				run.lastNewLine = block + std::bit_width(newLineMask) - 1;
+			}
+		}
+
+		// returns true if a delimiter was found in the block
+		template <typename Mask>
+		bool Block(char const * const block, Mask const delimiterMask, Mask newLineMask, Run & run)
+		{
+			if (delimiterMask == 0)
+			{
+				CountNewLines(block, newLineMask, run);
+				return false;
+			}
+
+			auto const offset = std::countr_zero(delimiterMask);
+			newLineMask &= static_cast<Mask>((Mask {1} << offset) - 1);
+			CountNewLines(block, newLineMask, run);
+			run.end = block + offset;
+			return true;
+		}
+
+#if defined(GLIB_XML_SCANNER_AVX2)
+		inline constexpr size_t BlockSize = 32;
+
+		template <size_t N>
+		Run Skip(char const * ptr, char const * const end, Delimiters<N> const & delimiters, Run run)
+		{
+			__m256i const newLine = _mm256_set1_epi8(NewLine);
+
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(BlockSize); ptr += BlockSize)
+			{
+				__m256i const data = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				__m256i found = _mm256_setzero_si256();
+				for (char const delimiter : delimiters)
+				{
+					found = _mm256_or_si256(found, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(delimiter)));
+				}
+				auto const delimiterMask = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+				auto const newLineMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, newLine)));
+				if (Block(ptr, delimiterMask, newLineMask, run))
+				{
+					return run;
+				}
+			}
+			return SkipScalar(ptr, end, delimiters, run);
+		}
+
+		template <size_t N>
+		char const * Find(char const * ptr, char const * const end, Delimiters<N> const & delimiters)
+		{
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(BlockSize); ptr += BlockSize)
+			{
+				__m256i const data = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				__m256i found = _mm256_setzero_si256();
+				for (char const delimiter : delimiters)
+				{
+					found = _mm256_or_si256(found, _mm256_cmpeq_epi8(data, _mm256_set1_epi8(delimiter)));
+				}
+				if (auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(found)); mask != 0)
+				{
+					return ptr + std::countr_zero(mask);
+				}
+			}
+			return FindScalar(ptr, end, delimiters);
+		}
+#elif defined(GLIB_XML_SCANNER_SSE2)
+		inline constexpr size_t BlockSize = 16;
+
+		template <size_t N>
+		Run Skip(char const * ptr, char const * const end, Delimiters<N> const & delimiters, Run run)
+		{
+			__m128i const newLine = _mm_set1_epi8(NewLine);
+
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(BlockSize); ptr += BlockSize)
+			{
+				__m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				__m128i found = _mm_setzero_si128();
+				for (char const delimiter : delimiters)
+				{
+					found = _mm_or_si128(found, _mm_cmpeq_epi8(data, _mm_set1_epi8(delimiter)));
+				}
+				auto const delimiterMask = static_cast<uint16_t>(_mm_movemask_epi8(found));
+				auto const newLineMask = static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, newLine)));
+				if (Block(ptr, delimiterMask, newLineMask, run))
+				{
+					return run;
+				}
+			}
+			return SkipScalar(ptr, end, delimiters, run);
+		}
+
+		template <size_t N>
+		char const * Find(char const * ptr, char const * const end, Delimiters<N> const & delimiters)
+		{
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(BlockSize); ptr += BlockSize)
+			{
+				__m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				__m128i found = _mm_setzero_si128();
+				for (char const delimiter : delimiters)
+				{
+					found = _mm_or_si128(found, _mm_cmpeq_epi8(data, _mm_set1_epi8(delimiter)));
+				}
+				if (auto const mask = static_cast<uint16_t>(_mm_movemask_epi8(found)); mask != 0)
+				{
+					return ptr + std::countr_zero(mask);
+				}
+			}
+			return FindScalar(ptr, end, delimiters);
+		}
+#else
+		template <size_t N>
+		Run Skip(char const * ptr, char const * const end, Delimiters<N> const & delimiters, Run run)
+		{
+			return SkipScalar(ptr, end, delimiters, run);
+		}
+
+		template <size_t N>
+		char const * Find(char const * ptr, char const * const end, Delimiters<N> const & delimiters)
+		{
+			return FindScalar(ptr, end, delimiters);
+		}
+#endif
+	}
+
+	// first position in [ptr, end) holding any of the delimiters, or end
+	template <size_t N>
+	Run Skip(char const * const ptr, char const * const end, Delimiters<N> const & delimiters)
+	{
+		return Detail::Skip(ptr, end, delimiters, Run {end, 0, nullptr});
+	}
+
+	template <size_t N>
+	Run SkipScalar(char const * const ptr, char const * const end, Delimiters<N> const & delimiters)
+	{
+		return Detail::SkipScalar(ptr, end, delimiters, Run {end, 0, nullptr});
+	}
+
+	// as Skip without the newline count
+	template <size_t N>
+	char const * Find(char const * const ptr, char const * const end, Delimiters<N> const & delimiters)
+	{
+		return Detail::Find(ptr, end, delimiters);
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string_view>
+
+namespace GLib::Xml
+{
+	// supplies a document to a streaming Iterator in chunks
+	class Source
+	{
+	public:
+		Source() = default;
+		Source(Source const &) = delete;
+		Source(Source &&) = delete;
+		Source & operator=(Source const &) = delete;
+		Source & operator=(Source &&) = delete;
+		virtual ~Source() = default;
+
+		// pending is the unconsumed tail of the previous result, returns it followed by more input
+		// views into earlier results are invalidated, a result no longer than pending signals the end of input
+		virtual std::string_view Refill(std::string_view pending) = 0;
+
+		// false while more input may still arrive, an iterator then suspends at the end of the data rather than ending
+		[[nodiscard]] virtual bool Finished() const
+		{
+			return true;
+		}
+	};
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <array>
-#include <cctype>
+#include <cstdint>
 
 namespace GLib::Xml
 {
@@ -45,509 +45,526 @@ namespace GLib::Xml
 		Count
 	};
 
-	class StateEngine
+	namespace Detail
 	{
-		static constexpr char leftAngleBracket = '<';
-		static constexpr char rightAngleBracket = '>';
-		static constexpr char forwardSlash = '/';
-		static constexpr char equals = '=';
-		static constexpr char doubleQuote = '"';
-		static constexpr char singleQuote = '\'';
-		static constexpr char colon = ':';
-		static constexpr char semiColon = ';';
-		static constexpr char underscore = '_';
-		static constexpr char fullStop = '.';
-		static constexpr char hyphen = '-';
-		static constexpr char exclamation = '!';
-		static constexpr char dash = '-';
-		static constexpr char questionMark = '?';
-		static constexpr char leftSquareBracket = '[';
-		static constexpr char rightSquareBracket = ']';
-		static constexpr char ampersand = '&';
-
-		static constexpr EnumType continuationMask = 0x80U;
-
-		using StateFunction = State (StateEngine::*)(char) const;
-
-		// use Phase : Prologue, Document, End
-		// could also manage depth here to determine end
-		// but try in iterator first?
-		State state;
-		bool mutable isProlog {true};
-		bool mutable hasDocTypeDecl {};
-		bool mutable hasContent {};
-		char mutable attributeQuoteChar {};
-		StateFunction stateFunction;
-
-	public:
-		explicit StateEngine(State state = State::Start)
-			: state(state)
-			, stateFunction(stateFunctions.at(static_cast<EnumType>(state)))
-		{}
-
-		State GetState() const
-		{
-			return state;
-		}
-
-		bool HasRootElement() const
-		{
-			return !isProlog;
-		}
-
-		State Push(char const value)
-		{
-			SetState((this->*stateFunction)(value));
-			return state;
-		}
-
-	private:
-		static bool IsContinuation(char const chr)
-		{
-			return (static_cast<EnumType>(chr) & continuationMask) != 0;
-		}
-
-		static bool IsWhiteSpace(char const chr)
-		{
-			return !IsContinuation(chr) && std::isspace(chr) != 0;
-		}
-
-		static bool IsNameStart(char const chr)
-		{
-			return IsContinuation(chr) || std::isalpha(chr) != 0 || chr == colon || chr == underscore; // check docs
-		}
-
-		static bool IsName(char const chr)
-		{
-			return IsNameStart(chr) || std::isdigit(chr) != 0 || chr == fullStop || chr == hyphen; // check docs
-		}
-
-		static bool IsAllowedTextCharacter(char const chr)
-		{
-			return chr != leftAngleBracket;
-		}
-
-		void SetState(State const newState)
-		{
-			if (newState != state)
-			{
-				state = newState;
-				stateFunction = stateFunctions.at(static_cast<EnumType>(state));
-			}
-		}
-
-		////////////////////////
-		// state functions
-		State Error(char const chr) const
-		{
-			static_cast<void>(chr);
-			return state;
-		}
-
-		State Start(char const chr) const
-		{
-			if (chr == leftAngleBracket)
-			{
-				return State::ElementStart;
-			}
-			if (IsWhiteSpace(chr))
-			{
-				hasContent = true;
-				return state;
-			}
-			if (!isProlog && IsAllowedTextCharacter(chr))
-			{
-				return State::Text;
-			}
-			return State::Error;
-		}
-
-		State DocTypeDecl(char const chr) const
-		{
-			if (IsName(chr) || IsWhiteSpace(chr))
-			{
-				return state;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			return state;
-		}
-
-		State ElementStart(char const chr) const
-		{
-			if (IsNameStart(chr))
-			{
-				isProlog = false;
-				hasContent = true;
-				return State::ElementName;
-			}
-			if (chr == forwardSlash)
-			{
-				return State::ElementEnd;
-			}
-			if (chr == exclamation)
-			{
-				hasContent = true;
-				return State::Bang;
-			}
-			if (chr == questionMark && !hasContent)
-			{
-				return State::XmlDeclaration;
-			}
-			return State::Error;
-		}
-
-		State ElementEnd(char const chr) const
-		{
-			static_cast<void>(this);
-			if (IsNameStart(chr))
-			{
-				return State::ElementEndName;
-			}
-			return State::Error;
-		}
-
-		State ElementEndName(char const chr) const
-		{
-			if (IsName(chr))
-			{
-				return state;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			if (IsWhiteSpace(chr))
-			{
-				return State::ElementEndSpace;
-			}
-			return State::Error;
-		}
-
-		State ElementEndSpace(char const chr) const
-		{
-			if (IsWhiteSpace(chr))
-			{
-				return state;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			return State::Error;
-		}
-
-		State ElementName(char const chr) const
-		{
-			if (IsName(chr))
-			{
-				return state;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			if (chr == forwardSlash)
-			{
-				return State::EmptyElement;
-			}
-			if (IsWhiteSpace(chr))
-			{
-				return State::AttributeSpace;
-			}
-			return State::Error;
-		}
-
-		State EmptyElement(char const chr) const
-		{
-			static_cast<void>(this);
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			return State::Error;
-		}
-
-		State AttributeSpace(char const chr) const
-		{
-			if (IsWhiteSpace(chr))
-			{
-				return state;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			if (chr == forwardSlash)
-			{
-				return State::EmptyElement;
-			}
-			if (IsNameStart(chr))
-			{
-				return State::AttributeName;
-			}
-			return State::Error;
-		}
+		// every character maps to one class, transitions only depend on the class
+		enum class CharClass : EnumType
+		{
+			Other,
+			WhiteSpace,
+			NameStart,
+			NameChar,
+			Hyphen,
+			LeftAngleBracket,
+			RightAngleBracket,
+			ForwardSlash,
+			Equals,
+			DoubleQuote,
+			SingleQuote,
+			Exclamation,
+			QuestionMark,
+			LeftSquareBracket,
+			RightSquareBracket,
+			Ampersand,
+			SemiColon,
+
+			Count
+		};
 
-		State AttributeName(char const chr) const
-		{
-			if (IsName(chr))
-			{
-				return state;
-			}
-			if (IsWhiteSpace(chr))
-			{
-				return State::AttributeNameSpace;
-			}
-			if (chr == equals)
-			{
-				return State::AttributeValueStart;
-			}
-			return State::Error;
-		}
+		// transitions that depend on engine flags or the character value rather than just the class
+		enum class Action : EnumType
+		{
+			None,
+			Content,
+			PrologText,
+			RootElement,
+			BangContent,
+			Declaration,
+			DocType,
+			OpenQuote,
+			Quote,
+		};
 
-		State AttributeNameSpace(char const chr) const
+		struct Transition
 		{
-			if (IsWhiteSpace(chr))
-			{
-				return state;
-			}
-			if (chr == equals)
-			{
-				return State::AttributeValueStart;
-			}
-			return State::Error;
-		}
+			State state;
+			Action action;
+		};
 
-		State AttributeValueStart(char const chr) const
-		{
-			if (IsWhiteSpace(chr))
-			{
-				return state;
-			}
-			if (chr == doubleQuote || chr == singleQuote)
-			{
-				attributeQuoteChar = chr;
-				return State::AttributeValue;
-			}
-			return State::Error;
-		}
+		inline constexpr unsigned int CharCount = 256;
+		inline constexpr unsigned int StateCount = static_cast<unsigned int>(State::Count);
+		inline constexpr unsigned int CharClassCount = static_cast<unsigned int>(CharClass::Count);
 
-		State AttributeValue(char const chr) const
-		{
-			if (chr == attributeQuoteChar)
-			{
-				return State::AttributeEnd;
-			}
-			if (chr == ampersand)
-			{
-				return State::AttributeEntity;
-			}
-			if (IsAllowedTextCharacter(chr))
-			{
-				return state;
-			}
-			return State::Error;
-		}
+		using CharClasses = std::array<CharClass, CharCount>;
+		using TransitionTable = std::array<std::array<Transition, CharClassCount>, StateCount>;
 
-		State AttributeEnd(char const chr) const
-		{
-			static_cast<void>(this);
-			if (IsWhiteSpace(chr))
-			{
-				return State::AttributeSpace;
-			}
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			if (chr == forwardSlash)
-			{
-				return State::EmptyElement;
-			}
-			return State::Error;
-		}
+		inline constexpr unsigned char continuationMask = 0x80U;
 
-		State Text(char const chr) const
+		constexpr CharClass Classify(unsigned char const chr)
 		{
-			if (chr == leftAngleBracket)
-			{
-				return State::ElementStart;
-			}
-			if (chr == ampersand)
+			if ((chr & continuationMask) != 0)
 			{
-				return State::TextEntity;
+				return CharClass::NameStart;
 			}
-			if (IsAllowedTextCharacter(chr))
-			{
-				return state;
-			}
-			return State::Error;
-		}
 
-		State Bang(char const chr) const
-		{
-			if (chr == dash)
-			{
-				return State::CommentStartDash;
-			}
-			if (chr == leftSquareBracket)
+			switch (chr)
 			{
-				return State::CDataName;
-			}
-			if (isProlog && !hasDocTypeDecl && IsNameStart(chr))
+				case ' ':
+				case '\t':
+				case '\n':
+				case '\v':
+				case '\f':
+				case '\r':
+					return CharClass::WhiteSpace;
+				case ':':
+				case '_':
+					return CharClass::NameStart;
+				case '.':
+					return CharClass::NameChar;
+				case '-':
+					return CharClass::Hyphen;
+				case '<':
+					return CharClass::LeftAngleBracket;
+				case '>':
+					return CharClass::RightAngleBracket;
+				case '/':
+					return CharClass::ForwardSlash;
+				case '=':
+					return CharClass::Equals;
+				case '"':
+					return CharClass::DoubleQuote;
+				case '\'':
+					return CharClass::SingleQuote;
+				case '!':
+					return CharClass::Exclamation;
+				case '?':
+					return CharClass::QuestionMark;
+				case '[':
+					return CharClass::LeftSquareBracket;
+				case ']':
+					return CharClass::RightSquareBracket;
+				case '&':
+					return CharClass::Ampersand;
+				case ';':
+					return CharClass::SemiColon;
+				default:
+					break;
+			}
+
+			if ((chr >= 'a' && chr <= 'z') || (chr >= 'A' && chr <= 'Z'))
 			{
-				hasDocTypeDecl = true;
-				return State::DocTypeDecl;
-			}
-			return State::Error;
-		}
-
-		State CommentStartDash(char const chr) const
-		{
-			static_cast<void>(this);
-			if (chr == dash)
-			{
-				return State::Comment;
-			}
-			return State::Error;
-		}
-
-		State Comment(char const chr) const
-		{
-			if (chr == dash)
-			{
-				return State::CommentEndDash;
-			}
-			return state;
-		}
-
-		State CommentEndDash(char const chr) const
-		{
-			static_cast<void>(this);
-			if (chr == dash)
-			{
-				return State::CommentEnd;
-			}
-			return State::Comment;
-		}
-
-		State CommentEnd(char const chr) const
-		{
-			static_cast<void>(this);
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			return State::Error;
-		}
-
-		State XmlDeclaration(char const chr) const
-		{
-			if (chr == questionMark)
-			{
-				return State::EmptyElement;
-			}
-			return state;
-		}
+				return CharClass::NameStart;
+			}
+			if (chr >= '0' && chr <= '9')
+			{
+				return CharClass::NameChar;
+			}
+			return CharClass::Other;
+		}
+
+		constexpr CharClasses MakeCharClasses()
+		{
+			CharClasses classes {};
+			for (unsigned int chr = 0; chr < CharCount; ++chr)
+			{
+				classes.at(chr) = Classify(static_cast<unsigned char>(chr));
+			}
+			return classes;
+		}
+
+		constexpr bool IsName(CharClass const cls)
+		{
+			return cls == CharClass::NameStart || cls == CharClass::NameChar || cls == CharClass::Hyphen;
+		}
+
+		constexpr bool IsQuote(CharClass const cls)
+		{
+			return cls == CharClass::DoubleQuote || cls == CharClass::SingleQuote;
+		}
+
+		constexpr Transition To(State const state, Action const action = Action::None)
+		{
+			return {state, action};
+		}
+
+		// must match the per character rules of the original state functions
+		constexpr Transition Compute(State const state, CharClass const cls) // NOLINT(readability-function-cognitive-complexity) one case per state
+		{
+			auto const same = To(state);
+			auto const error = To(State::Error);
+
+			switch (state)
+			{
+				case State::Error:
+				{
+					return same;
+				}
+
+				case State::Start:
+				{
+					if (cls == CharClass::LeftAngleBracket)
+					{
+						return To(State::ElementStart);
+					}
+					if (cls == CharClass::WhiteSpace)
+					{
+						return To(State::Start, Action::Content);
+					}
+					return To(State::Text, Action::PrologText);
+				}
+
+				case State::DocTypeDecl:
+				{
+					return cls == CharClass::RightAngleBracket ? To(State::Start) : same;
+				}
+
+				case State::ElementStart:
+				{
+					switch (cls)
+					{
+						case CharClass::NameStart:
+							return To(State::ElementName, Action::RootElement);
+						case CharClass::ForwardSlash:
+							return To(State::ElementEnd);
+						case CharClass::Exclamation:
+							return To(State::Bang, Action::BangContent);
+						case CharClass::QuestionMark:
+							return To(State::XmlDeclaration, Action::Declaration);
+						default:
+							return error;
+					}
+				}
+
+				case State::ElementEnd:
+				{
+					return cls == CharClass::NameStart ? To(State::ElementEndName) : error;
+				}
+
+				case State::ElementEndName:
+				{
+					if (IsName(cls))
+					{
+						return same;
+					}
+					if (cls == CharClass::RightAngleBracket)
+					{
+						return To(State::Start);
+					}
+					return cls == CharClass::WhiteSpace ? To(State::ElementEndSpace) : error;
+				}
+
+				case State::ElementEndSpace:
+				{
+					if (cls == CharClass::WhiteSpace)
+					{
+						return same;
+					}
+					return cls == CharClass::RightAngleBracket ? To(State::Start) : error;
+				}
+
+				case State::ElementName:
+				{
+					if (IsName(cls))
+					{
+						return same;
+					}
+					switch (cls)
+					{
+						case CharClass::RightAngleBracket:
+							return To(State::Start);
+						case CharClass::ForwardSlash:
+							return To(State::EmptyElement);
+						case CharClass::WhiteSpace:
+							return To(State::AttributeSpace);
+						default:
+							return error;
+					}
+				}
+
+				case State::EmptyElement:
+				{
+					return cls == CharClass::RightAngleBracket ? To(State::Start) : error;
+				}
+
+				case State::AttributeSpace:
+				{
+					switch (cls)
+					{
+						case CharClass::WhiteSpace:
+							return same;
+						case CharClass::RightAngleBracket:
+							return To(State::Start);
+						case CharClass::ForwardSlash:
+							return To(State::EmptyElement);
+						case CharClass::NameStart:
+							return To(State::AttributeName);
+						default:
+							return error;
+					}
+				}
+
+				case State::AttributeName:
+				{
+					if (IsName(cls))
+					{
+						return same;
+					}
+					if (cls == CharClass::WhiteSpace)
+					{
+						return To(State::AttributeNameSpace);
+					}
+					return cls == CharClass::Equals ? To(State::AttributeValueStart) : error;
+				}
+
+				case State::AttributeNameSpace:
+				{
+					if (cls == CharClass::WhiteSpace)
+					{
+						return same;
+					}
+					return cls == CharClass::Equals ? To(State::AttributeValueStart) : error;
+				}
+
+				case State::AttributeValueStart:
+				{
+					if (cls == CharClass::WhiteSpace)
+					{
+						return same;
+					}
+					return IsQuote(cls) ? To(State::AttributeValue, Action::OpenQuote) : error;
+				}
+
+				case State::AttributeValue:
+				{
+					if (IsQuote(cls))
+					{
+						return To(State::AttributeValue, Action::Quote);
+					}
+					if (cls == CharClass::Ampersand)
+					{
+						return To(State::AttributeEntity);
+					}
+					return cls == CharClass::LeftAngleBracket ? error : same;
+				}
+
+				case State::AttributeEnd:
+				{
+					switch (cls)
+					{
+						case CharClass::WhiteSpace:
+							return To(State::AttributeSpace);
+						case CharClass::RightAngleBracket:
+							return To(State::Start);
+						case CharClass::ForwardSlash:
+							return To(State::EmptyElement);
+						default:
+							return error;
+					}
+				}
+
+				case State::Text:
+				{
+					if (cls == CharClass::LeftAngleBracket)
+					{
+						return To(State::ElementStart);
+					}
+					return cls == CharClass::Ampersand ? To(State::TextEntity) : same;
+				}
+
+				case State::Bang:
+				{
+					switch (cls)
+					{
+						case CharClass::Hyphen:
+							return To(State::CommentStartDash);
+						case CharClass::LeftSquareBracket:
+							return To(State::CDataName);
+						case CharClass::NameStart:
+							return To(State::DocTypeDecl, Action::DocType);
+						default:
+							return error;
+					}
+				}
+
+				case State::CommentStartDash:
+				{
+					return cls == CharClass::Hyphen ? To(State::Comment) : error;
+				}
+
+				case State::Comment:
+				{
+					return cls == CharClass::Hyphen ? To(State::CommentEndDash) : same;
+				}
+
+				case State::CommentEndDash:
+				{
+					return cls == CharClass::Hyphen ? To(State::CommentEnd) : To(State::Comment);
+				}
+
+				case State::CommentEnd:
+				{
+					return cls == CharClass::RightAngleBracket ? To(State::Start) : error;
+				}
+
+				case State::XmlDeclaration:
+				{
+					return cls == CharClass::QuestionMark ? To(State::EmptyElement) : same;
+				}
+
+				case State::CDataName:
+				{
+					return cls == CharClass::LeftSquareBracket ? To(State::CDataValue) : same;
+				}
+
+				case State::CDataValue:
+				{
+					return cls == CharClass::RightSquareBracket ? To(State::CDataEnd1) : same;
+				}
+
+				case State::CDataEnd1:
+				{
+					return cls == CharClass::RightSquareBracket ? To(State::CDataEnd2) : To(State::CDataValue);
+				}
+
+				case State::CDataEnd2:
+				{
+					return cls == CharClass::RightAngleBracket ? To(State::Start) : To(State::CDataValue);
+				}
+
+				case State::TextEntity:
+				{
+					// todo: validate chars, more states for decimal, hex numbers
+					return cls == CharClass::SemiColon ? To(State::Text) : same;
+				}
+
+				case State::AttributeEntity:
+				{
+					// todo: validate chars, more states for decimal, hex numbers
+					return cls == CharClass::SemiColon ? To(State::AttributeValue) : same;
+				}
+
+				case State::Count:
+				{
+					break;
+				}
+			}
+			return error;
+		}
+
+		constexpr TransitionTable MakeTransitions()
+		{
+			TransitionTable table {};
+			for (unsigned int state = 0; state < StateCount; ++state)
+			{
+				for (unsigned int cls = 0; cls < CharClassCount; ++cls)
+				{
+					table.at(state).at(cls) = Compute(static_cast<State>(state), static_cast<CharClass>(cls));
+				}
+			}
+			return table;
+		}
+
+		inline constexpr CharClasses charClasses = MakeCharClasses();
+		inline constexpr TransitionTable transitions = MakeTransitions();
+	}
+
+	// table driven, one lookup per character indexed by state and character class
+	// the few transitions that depend on document flags are resolved in Apply
+	class StateEngine
+	{
+		// use Phase : Prologue, Document, End
+		// could also manage depth here to determine end
+		// but try in iterator first?
+		State state;
+		bool isProlog {true};
+		bool hasDocTypeDecl {};
+		bool hasContent {};
+		char attributeQuoteChar {};
 
-		State CDataName(char const chr) const
-		{
-			if (chr == leftSquareBracket)
-			{
-				return State::CDataValue;
-			}
-			return state;
-		}
+	public:
+		explicit StateEngine(State const state = State::Start)
+			: state(state)
+		{}
 
-		State CDataValue(char const chr) const
+		[[nodiscard]] State GetState() const
 		{
-			if (chr == rightSquareBracket)
-			{
-				return State::CDataEnd1;
-			}
 			return state;
 		}
 
-		State CDataEnd1(char const chr) const
+		[[nodiscard]] bool HasRootElement() const
 		{
-			static_cast<void>(this);
-			if (chr == rightSquareBracket)
-			{
-				return State::CDataEnd2;
-			}
-			return State::CDataValue;
+			return !isProlog;
 		}
 
-		State CDataEnd2(char const chr) const
+		[[nodiscard]] char QuoteChar() const
 		{
-			static_cast<void>(this);
-			if (chr == rightAngleBracket)
-			{
-				return State::Start;
-			}
-			return State::CDataValue;
+			return attributeQuoteChar;
 		}
 
-		State TextEntity(char const chr) const
+		State Push(char const value)
 		{
-			if (chr == semiColon)
-			{
-				return State::Text;
-			}
-			// todo: validate chars, more states for decimal, hex numbers
+			auto const chr = static_cast<unsigned char>(value);
+			auto const & transition = Detail::transitions[static_cast<EnumType>(state)][static_cast<EnumType>(Detail::charClasses[chr])];
+			state = transition.action == Detail::Action::None ? transition.state : Apply(transition, value);
 			return state;
 		}
 
-		State AttributeEntity(char const chr) const
-		{
-			if (chr == semiColon)
-			{
-				return State::AttributeValue;
-			}
-			// todo: validate chars, more states for decimal, hex numbers
-			return state;
+	private:
+		State Apply(Detail::Transition const & transition, char const value)
+		{
+			switch (transition.action)
+			{
+				case Detail::Action::Content:
+				case Detail::Action::BangContent:
+				{
+					hasContent = true;
+					return transition.state;
+				}
+
+				case Detail::Action::PrologText:
+				{
+					return isProlog ? State::Error : transition.state;
+				}
+
+				case Detail::Action::RootElement:
+				{
+					isProlog = false;
+					hasContent = true;
+					return transition.state;
+				}
+
+				case Detail::Action::Declaration:
+				{
+					return hasContent ? State::Error : transition.state;
+				}
+
+				case Detail::Action::DocType:
+				{
+					if (!isProlog || hasDocTypeDecl)
+					{
+						return State::Error;
+					}
+					hasDocTypeDecl = true;
+					return transition.state;
+				}
+
+				case Detail::Action::OpenQuote:
+				{
+					attributeQuoteChar = value;
+					return transition.state;
+				}
+
+				case Detail::Action::Quote:
+				{
+					return value == attributeQuoteChar ? State::AttributeEnd : transition.state;
+				}
+
+				case Detail::Action::None:
+				{
+					break;
+				}
+			}
+			return transition.state;
 		}
-
-		// state functions
-		//////////////////////
-
-		// must be enum order
-		static constexpr std::array<StateFunction, static_cast<int>(State::Count)> stateFunctions = {
-			&StateEngine::Error,
-			&StateEngine::Start,
-			&StateEngine::DocTypeDecl,
-			&StateEngine::ElementStart,
-			&StateEngine::ElementEnd,
-			&StateEngine::ElementEndName,
-			&StateEngine::ElementEndSpace,
-			&StateEngine::ElementName,
-			&StateEngine::EmptyElement,
-			&StateEngine::AttributeSpace,
-			&StateEngine::AttributeName,
-			&StateEngine::AttributeNameSpace,
-			&StateEngine::AttributeValueStart,
-			&StateEngine::AttributeValue,
-			&StateEngine::AttributeEnd,
-			&StateEngine::Text,
-
-			&StateEngine::Bang,
-			&StateEngine::CommentStartDash,
-			&StateEngine::Comment,
-			&StateEngine::CommentEndDash,
-			&StateEngine::CommentEnd,
-
-			&StateEngine::XmlDeclaration,
-
-			&StateEngine::CDataName,
-			&StateEngine::CDataValue,
-			&StateEngine::CDataEnd1,
-			&StateEngine::CDataEnd2,
-
-			&StateEngine::TextEntity,
-			&StateEngine::AttributeEntity,
-		};
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <GLib/Compat.h>
+#include <GLib/Xml/Iterator.h>
+#include <GLib/Xml/Source.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <vector>
+
+/*
+Streaming input, for documents too large to hold in memory
+the buffer only keeps the unconsumed tail of the current element, so its size depends on the largest element
+element views, including namespace values, are valid until the next increment
+*/
+
+namespace GLib::Xml
+{
+	// reads into buffer, returns the number of characters read, zero at end of input
+	using Reader = std::function<size_t(char * buffer, size_t size)>;
+
+	class StreamSource : public Source
+	{
+		static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+		Reader reader;
+		size_t const chunkSize;
+		std::vector<char> buffer;
+
+	public:
+		explicit StreamSource(Reader reader, size_t const chunkSize = DefaultChunkSize)
+			: reader(std::move(reader))
+			, chunkSize(std::max<size_t>(chunkSize, 1))
+		{}
+
+		explicit StreamSource(std::istream & stream, size_t const chunkSize = DefaultChunkSize)
+			: StreamSource(
+					[&stream](char * const buffer, size_t const size)
+					{
+						stream.read(buffer, static_cast<std::streamsize>(size));
+						if (stream.bad())
+						{
+							throw std::runtime_error("Stream read failed");
+						}
+						return static_cast<size_t>(stream.gcount());
+					},
+					chunkSize)
+		{}
+
+		explicit StreamSource(int const fd, size_t const chunkSize = DefaultChunkSize)
+			: StreamSource([fd](char * const buffer, size_t const size) { return Compat::Read(fd, buffer, size); }, chunkSize)
+		{}
+
+		std::string_view Refill(std::string_view const pending) override
+		{
+			size_t const kept = pending.size();
+			if (kept != 0 && pending.data() != buffer.data())
+			{
+				std::memmove(buffer.data(), pending.data(), kept);
+			}
+
+			// grow when an element spans most of the buffer so reads stay at least a chunk
+			if (buffer.size() - kept < chunkSize)
+			{
+				buffer.resize(std::max(buffer.size() * 2, kept + chunkSize));
+			}
+
+			size_t const read = reader(buffer.data() + kept, buffer.size() - kept);
+			return {buffer.data(), kept + read};
+		}
+
+		[[nodiscard]] size_t Capacity() const
+		{
+			return buffer.size();
+		}
+	};
+
+	class StreamHolder
+	{
+		StreamSource source;
+		NameSpaceManager manager {true};
+		Utf8::Validation const validation {};
+
+	public:
+		template <typename... Args>
+		explicit StreamHolder(Args &&... args)
+			: source(std::forward<Args>(args)...)
+		{}
+
+		template <typename... Args>
+		explicit StreamHolder(Utf8::Validation const validation, Args &&... args)
+			: source(std::forward<Args>(args)...)
+			, validation(validation)
+		{}
+
+		// single pass, the input is consumed
+		Iterator begin()
+		{
+			return {source, &manager, validation};
+		}
+
+		[[nodiscard]] Iterator end() const
+		{
+			static_cast<void>(this);
+			return Iterator {};
+		}
+
+		NameSpaceManager const & Manager()
+		{
+			return manager;
+		}
+
+		[[nodiscard]] size_t BufferSize() const
+		{
+			return source.Capacity();
+		}
+	};
+}
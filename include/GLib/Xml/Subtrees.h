@@ -0,0 +1,233 @@
+#pragma once
+
+#include <GLib/ParallelFor.h>
+#include <GLib/Xml/Iterator.h>
+
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/*
+Parallel parsing of the element children of the root, for documents that are a long list of sibling records
+a structural pre-scan only tracks tags, comments, cdata and processing instructions to find where each child starts and ends
+each child is then parsed as its own document with a NameSpaceManager seeded from the root declarations
+child element depths and error positions are relative to the child, text directly under the root is not reported
+*/
+
+namespace GLib::Xml
+{
+	class Subtrees
+	{
+		NameSpaceManager manager;
+		std::string_view rootName;
+		std::vector<std::string_view> children;
+
+	public:
+		explicit Subtrees(std::string_view const xml)
+		{
+			Holder holder {xml};
+			auto it = holder.begin();
+			while (it != holder.end() && it->Type() == ElementType::Comment)
+			{
+				++it;
+			}
+
+			rootName = it->QName();
+			manager = holder.Manager();
+			auto const rootEnd = static_cast<size_t>(it->OuterXml().data() + it->OuterXml().size() - xml.data());
+			if (it->Type() == ElementType::Open)
+			{
+				Scan(xml, rootEnd);
+			}
+			else
+			{
+				CheckTrailing(xml, rootEnd);
+			}
+		}
+
+		[[nodiscard]] std::string_view RootName() const
+		{
+			return rootName;
+		}
+
+		[[nodiscard]] std::vector<std::string_view> const & Children() const
+		{
+			return children;
+		}
+
+		[[nodiscard]] Holder Child(size_t const index) const
+		{
+			return Holder {children[index], manager};
+		}
+
+	private:
+		static size_t Find(std::string_view const xml, std::string_view const value, size_t const pos)
+		{
+			size_t const find = xml.find(value, pos);
+			if (find == std::string_view::npos)
+			{
+				throw std::runtime_error("Xml not closed");
+			}
+			return find + value.size();
+		}
+
+		// position after the '>' ending the tag starting at pos, quoted attribute values may contain '>'
+		// tags are short so a plain loop beats setting up a vector search
+		static size_t TagEnd(std::string_view const xml, size_t pos)
+		{
+			for (char quote {}; pos != xml.size(); ++pos)
+			{
+				char const chr = xml[pos];
+				if (quote != 0)
+				{
+					quote = chr == quote ? char {} : quote;
+				}
+				else if (chr == '"' || chr == '\'')
+				{
+					quote = chr;
+				}
+				else if (chr == '>')
+				{
+					return pos + 1;
+				}
+			}
+			throw std::runtime_error("Xml not closed");
+		}
+
+		static bool StartsWith(std::string_view const xml, size_t const pos, std::string_view const value)
+		{
+			return xml.compare(pos, value.size(), value) == 0;
+		}
+
+		void Scan(std::string_view const xml, size_t pos)
+		{
+			size_t depth {};
+			size_t childStart {};
+
+			for (;;)
+			{
+				pos = xml.find('<', pos);
+				if (pos == std::string_view::npos)
+				{
+					throw std::runtime_error("Xml not closed");
+				}
+
+				if (StartsWith(xml, pos, "<!--"))
+				{
+					pos = Find(xml, "-->", pos);
+				}
+				else if (StartsWith(xml, pos, "<![CDATA["))
+				{
+					pos = Find(xml, "]]>", pos);
+				}
+				else if (StartsWith(xml, pos, "<?"))
+				{
+					pos = Find(xml, "?>", pos);
+				}
+				else if (StartsWith(xml, pos, "</"))
+				{
+					size_t const tagEnd = TagEnd(xml, pos);
+					if (depth == 0)
+					{
+						CheckRootClose(xml.substr(pos, tagEnd - pos));
+						CheckTrailing(xml, tagEnd);
+						return;
+					}
+					if (--depth == 0)
+					{
+						children.push_back(xml.substr(childStart, tagEnd - childStart));
+					}
+					pos = tagEnd;
+				}
+				else
+				{
+					size_t const tagEnd = TagEnd(xml, pos);
+					if (depth == 0)
+					{
+						childStart = pos;
+					}
+					if (xml[tagEnd - 2] != '/')
+					{
+						++depth;
+					}
+					else if (depth == 0)
+					{
+						children.push_back(xml.substr(childStart, tagEnd - childStart));
+					}
+					pos = tagEnd;
+				}
+			}
+		}
+
+		void CheckRootClose(std::string_view const tag) const
+		{
+			constexpr std::string_view whiteSpace = " \t\r\n";
+			auto const name = tag.substr(2, tag.find_last_not_of(whiteSpace, tag.size() - 2) - 1);
+			if (name != rootName)
+			{
+				std::ostringstream stm;
+				stm << "Element mismatch: " << name << " != " << rootName;
+				throw std::runtime_error(stm.str());
+			}
+		}
+
+		// only white space, comments and processing instructions may follow the root
+		static void CheckTrailing(std::string_view const xml, size_t pos)
+		{
+			constexpr std::string_view whiteSpace = " \t\r\n";
+			for (pos = xml.find_first_not_of(whiteSpace, pos); pos != std::string_view::npos; pos = xml.find_first_not_of(whiteSpace, pos))
+			{
+				if (StartsWith(xml, pos, "<!--"))
+				{
+					pos = Find(xml, "-->", pos);
+				}
+				else if (StartsWith(xml, pos, "<?"))
+				{
+					pos = Find(xml, "?>", pos);
+				}
+				else
+				{
+					throw std::runtime_error("Extra content at document end");
+				}
+			}
+		}
+	};
+
+	// parses the children on up to threads threads, returns function(Holder &) for each child in document order
+	template <typename Function>
+	auto ParseSubtrees(Subtrees const & subtrees, Function const & function, size_t const threads = 0)
+	{
+		using Result = std::invoke_result_t<Function const &, Holder &>;
+
+		size_t const count = subtrees.Children().size();
+		std::vector<std::optional<Result>> results(count); // not vector<bool>, elements are written concurrently
+		ParallelFor(count,
+								threads,
+								[&](size_t const index)
+								{
+									auto holder = subtrees.Child(index);
+									results[index].emplace(function(holder));
+								});
+
+		std::vector<Result> ordered;
+		ordered.reserve(count);
+		for (auto & result : results)
+		{
+			ordered.push_back(std::move(*result));
+		}
+		return ordered;
+	}
+
+	// calls function(index, Holder &) for each child in no particular order, calls can be concurrent
+	template <typename Function>
+	void ForEachSubtree(Subtrees const & subtrees, Function const & function, size_t const threads = 0)
+	{
+		ParallelFor(subtrees.Children().size(),
+								threads,
+								[&](size_t const index)
+								{
+									auto holder = subtrees.Child(index);
+									function(index, holder);
+								});
+	}
+}
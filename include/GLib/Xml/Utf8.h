@@ -0,0 +1,301 @@
+#pragma once
+
+#include <GLib/Xml/Scanner.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+/*
+UTF-8 well formedness as a table driven state machine, one lookup for the byte class and one for the transition
+rejects overlong forms, surrogates, values above U+10FFFF and truncated or stray continuation bytes
+between sequences whole blocks of ASCII are passed with one vector compare, using the scanner's instruction set
+the state carries across calls so a sequence may be split between runs and refills
+*/
+
+namespace GLib::Xml::Utf8
+{
+	// optional checking by the iterator, off by default as input is usually validated at the boundary
+	enum class Validation : uint8_t
+	{
+		Off,
+		On
+	};
+
+	enum class State : uint8_t
+	{
+		Accept,
+		Reject,
+		Tail1,	 // one continuation byte left
+		Tail2,	 // two left
+		Tail3,	 // three left
+		LeadE0, // second byte A0-BF, no overlong three byte forms
+		LeadED, // second byte 80-9F, no surrogates
+		LeadF0, // second byte 90-BF, no overlong four byte forms
+		LeadF4, // second byte 80-8F, nothing above U+10FFFF
+
+		Count
+	};
+
+	namespace Detail
+	{
+		enum class ByteClass : uint8_t
+		{
+			Ascii,
+			Continuation80, // 80-8F
+			Continuation90, // 90-9F
+			ContinuationA0, // A0-BF
+			Lead2,					// C2-DF
+			LeadE0,
+			Lead3, // E1-EC, EE-EF
+			LeadED,
+			LeadF0,
+			Lead4, // F1-F3
+			LeadF4,
+			Invalid, // C0, C1, F5-FF
+
+			Count
+		};
+
+		inline constexpr unsigned int ByteCount = 256;
+		inline constexpr unsigned int StateCount = static_cast<unsigned int>(State::Count);
+		inline constexpr unsigned int ByteClassCount = static_cast<unsigned int>(ByteClass::Count);
+
+		constexpr ByteClass Classify(unsigned int const value)
+		{
+			if (value < 0x80U)
+			{
+				return ByteClass::Ascii;
+			}
+			if (value < 0x90U)
+			{
+				return ByteClass::Continuation80;
+			}
+			if (value < 0xA0U)
+			{
+				return ByteClass::Continuation90;
+			}
+			if (value < 0xC0U)
+			{
+				return ByteClass::ContinuationA0;
+			}
+			if (value < 0xC2U)
+			{
+				return ByteClass::Invalid;
+			}
+			if (value < 0xE0U)
+			{
+				return ByteClass::Lead2;
+			}
+			switch (value)
+			{
+				case 0xE0U:
+					return ByteClass::LeadE0;
+				case 0xEDU:
+					return ByteClass::LeadED;
+				case 0xF0U:
+					return ByteClass::LeadF0;
+				case 0xF4U:
+					return ByteClass::LeadF4;
+				default:
+					break;
+			}
+			if (value < 0xF0U)
+			{
+				return ByteClass::Lead3;
+			}
+			return value < 0xF4U ? ByteClass::Lead4 : ByteClass::Invalid;
+		}
+
+		constexpr bool IsContinuation(ByteClass const cls)
+		{
+			return cls == ByteClass::Continuation80 || cls == ByteClass::Continuation90 || cls == ByteClass::ContinuationA0;
+		}
+
+		constexpr State Compute(State const state, ByteClass const cls)
+		{
+			switch (state)
+			{
+				case State::Accept:
+				{
+					switch (cls)
+					{
+						case ByteClass::Ascii:
+							return State::Accept;
+						case ByteClass::Lead2:
+							return State::Tail1;
+						case ByteClass::LeadE0:
+							return State::LeadE0;
+						case ByteClass::Lead3:
+							return State::Tail2;
+						case ByteClass::LeadED:
+							return State::LeadED;
+						case ByteClass::LeadF0:
+							return State::LeadF0;
+						case ByteClass::Lead4:
+							return State::Tail3;
+						case ByteClass::LeadF4:
+							return State::LeadF4;
+						default:
+							return State::Reject;
+					}
+				}
+
+				case State::Tail1:
+				{
+					return IsContinuation(cls) ? State::Accept : State::Reject;
+				}
+
+				case State::Tail2:
+				{
+					return IsContinuation(cls) ? State::Tail1 : State::Reject;
+				}
+
+				case State::Tail3:
+				{
+					return IsContinuation(cls) ? State::Tail2 : State::Reject;
+				}
+
+				case State::LeadE0:
+				{
+					return cls == ByteClass::ContinuationA0 ? State::Tail1 : State::Reject;
+				}
+
+				case State::LeadED:
+				{
+					return cls == ByteClass::Continuation80 || cls == ByteClass::Continuation90 ? State::Tail1 : State::Reject;
+				}
+
+				case State::LeadF0:
+				{
+					return cls == ByteClass::Continuation90 || cls == ByteClass::ContinuationA0 ? State::Tail2 : State::Reject;
+				}
+
+				case State::LeadF4:
+				{
+					return cls == ByteClass::Continuation80 ? State::Tail2 : State::Reject;
+				}
+
+				default:
+				{
+					return State::Reject;
+				}
+			}
+		}
+
+		constexpr std::array<ByteClass, ByteCount> MakeByteClasses()
+		{
+			std::array<ByteClass, ByteCount> classes {};
+			for (unsigned int value = 0; value < ByteCount; ++value)
+			{
+				classes.at(value) = Classify(value);
+			}
+			return classes;
+		}
+
+		constexpr std::array<std::array<State, ByteClassCount>, StateCount> MakeTransitions()
+		{
+			std::array<std::array<State, ByteClassCount>, StateCount> transitions {};
+			for (unsigned int state = 0; state < StateCount; ++state)
+			{
+				for (unsigned int cls = 0; cls < ByteClassCount; ++cls)
+				{
+					transitions.at(state).at(cls) = Compute(static_cast<State>(state), static_cast<ByteClass>(cls));
+				}
+			}
+			return transitions;
+		}
+
+		inline constexpr auto byteClasses = MakeByteClasses();
+		inline constexpr auto transitions = MakeTransitions();
+
+		// first byte with the high bit set, or end
+		inline char const * SkipAscii(char const * ptr, char const * const end)
+		{
+#if defined(GLIB_XML_SCANNER_AVX2)
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(Scanner::Detail::BlockSize); ptr += Scanner::Detail::BlockSize)
+			{
+				__m256i const data = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				if (auto const mask = static_cast<uint32_t>(_mm256_movemask_epi8(data)); mask != 0)
+				{
+					return ptr + std::countr_zero(mask);
+				}
+			}
+#elif defined(GLIB_XML_SCANNER_SSE2)
+			for (; end - ptr >= static_cast<std::ptrdiff_t>(Scanner::Detail::BlockSize); ptr += Scanner::Detail::BlockSize)
+			{
+				__m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+				if (auto const mask = static_cast<uint16_t>(_mm_movemask_epi8(data)); mask != 0)
+				{
+					return ptr + std::countr_zero(mask);
+				}
+			}
+#endif
+			while (ptr != end && static_cast<unsigned char>(*ptr) < 0x80U)
+			{
+				++ptr;
+			}
+			return ptr;
+		}
+	}
+
+	[[nodiscard]] inline State Next(State const state, char const value)
+	{
+		return Detail::transitions[static_cast<uint8_t>(state)][static_cast<uint8_t>(Detail::byteClasses[static_cast<unsigned char>(value)])];
+	}
+
+	struct Result
+	{
+		char const * end; // the rejected byte, or the end of the input
+		State state;
+	};
+
+	// continues from state over [ptr, end), stops at the first byte that cannot continue a well formed sequence
+	[[nodiscard]] inline Result Validate(char const * ptr, char const * const end, State state = State::Accept)
+	{
+		while (ptr != end)
+		{
+			if (state == State::Accept)
+			{
+				ptr = Detail::SkipAscii(ptr, end);
+				if (ptr == end)
+				{
+					break;
+				}
+			}
+
+			state = Next(state, *ptr);
+			if (state == State::Reject)
+			{
+				return {ptr, state};
+			}
+			++ptr;
+		}
+		return {end, state};
+	}
+
+	// the end of the last whole character in [begin, end), a sequence cut by end is left out
+	[[nodiscard]] inline char const * WholeEnd(char const * const begin, char const * const end)
+	{
+		auto lead = end;
+		for (int i = 0; i < 3 && lead != begin && (static_cast<unsigned char>(lead[-1]) & 0xC0U) == 0x80U; ++i)
+		{
+			--lead;
+		}
+		if (lead == begin || static_cast<unsigned char>(lead[-1]) < 0xC0U)
+		{
+			return end;
+		}
+
+		--lead;
+		auto const value = static_cast<unsigned char>(*lead);
+		std::ptrdiff_t const length = value >= 0xF0U ? 4 : value >= 0xE0U ? 3 : 2;
+		return end - lead < length ? lead : end;
+	}
+
+	[[nodiscard]] inline bool IsValid(std::string_view const value)
+	{
+		return Validate(value.data(), value.data() + value.size()).state == State::Accept;
+	}
+}
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <GLib/Xml/Scanner.h>
+
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <ostream>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <utility>
 
@@ -25,29 +31,215 @@ namespace GLib::Xml::Utils
 	static constexpr auto EntitySize = 5;
 	static constexpr std::array Entities {Quot, Amp, Apos, Open, Close};
 
-	inline std::ostream & Escape(std::string_view value, std::ostream & out)
+	inline std::string_view EscapedForm(char const value)
+	{
+		switch (value)
+		{
+			case Quot.second:
+				return Quot.first;
+			case Amp.second:
+				return Amp.first;
+			case Apos.second:
+				return Apos.first;
+			case Open.second:
+				return Open.first;
+			case Close.second:
+				return Close.first;
+			default:
+				throw std::logic_error("Not an entity character");
+		}
+	}
+
+	// single pass, runs between entity characters are found with a vectorised scan and appended whole
+	// append is called as append(char const * data, size_t size)
+	template <typename Appender>
+	void EscapeTo(std::string_view const value, Appender && append)
 	{
-		for (size_t startPos = 0;;)
+		char const * ptr = value.data();
+		char const * const end = ptr + value.size();
+		for (;;)
 		{
-			std::string_view replacement;
-			size_t pos = std::string::npos;
-			for (auto const & [escaped, unescaped] : Entities)
+			char const * const found = Scanner::Find(ptr, end, Scanner::Delimiters<EntitySize> {Quot.second, Amp.second, Apos.second, Open.second, Close.second});
+			if (found != ptr)
+			{
+				append(ptr, static_cast<size_t>(found - ptr));
+			}
+			if (found == end)
+			{
+				return;
+			}
+			std::string_view const escaped = EscapedForm(*found);
+			append(escaped.data(), escaped.size());
+			ptr = found + 1;
+		}
+	}
+
+	inline void Escape(std::string_view const value, std::string & out)
+	{
+		EscapeTo(value, [&](char const * const data, size_t const size) { out.append(data, size); });
+	}
+
+	inline std::ostream & Escape(std::string_view const value, std::ostream & out)
+	{
+		EscapeTo(value, [&](char const * const data, size_t const size) { out.write(data, static_cast<std::streamsize>(size)); });
+		return out;
+	}
+
+	namespace Detail
+	{
+		[[noreturn]] inline void InvalidReference(std::string_view const reference)
+		{
+			throw std::runtime_error("Invalid character reference: " + std::string(reference));
+		}
+
+		inline char * AppendUtf8(uint32_t const codePoint, char * out)
+		{
+			constexpr uint32_t oneByte = 0x80;
+			constexpr uint32_t twoBytes = 0x800;
+			constexpr uint32_t threeBytes = 0x10000;
+			constexpr uint32_t sixBits = 0x3F;
+			constexpr uint32_t continuation = 0x80;
+
+			if (codePoint < oneByte)
+			{
+				*out++ = static_cast<char>(codePoint);
+			}
+			else if (codePoint < twoBytes)
+			{
+				*out++ = static_cast<char>(0xC0U | (codePoint >> 6U));
+				*out++ = static_cast<char>(continuation | (codePoint & sixBits));
+			}
+			else if (codePoint < threeBytes)
+			{
+				*out++ = static_cast<char>(0xE0U | (codePoint >> 12U));
+				*out++ = static_cast<char>(continuation | ((codePoint >> 6U) & sixBits));
+				*out++ = static_cast<char>(continuation | (codePoint & sixBits));
+			}
+			else
+			{
+				*out++ = static_cast<char>(0xF0U | (codePoint >> 18U));
+				*out++ = static_cast<char>(continuation | ((codePoint >> 12U) & sixBits));
+				*out++ = static_cast<char>(continuation | ((codePoint >> 6U) & sixBits));
+				*out++ = static_cast<char>(continuation | (codePoint & sixBits));
+			}
+			return out;
+		}
+
+		// reference is the text between '&#' and ';'
+		inline uint32_t ParseCharacterReference(std::string_view const reference, std::string_view const entity)
+		{
+			constexpr uint32_t maxCodePoint = 0x10FFFF;
+			constexpr uint32_t surrogateFirst = 0xD800;
+			constexpr uint32_t surrogateLast = 0xDFFF;
+			constexpr uint32_t decimal = 10;
+			constexpr uint32_t hex = 16;
+
+			bool const isHex = !reference.empty() && reference[0] == 'x';
+			std::string_view const digits = isHex ? reference.substr(1) : reference;
+			if (digits.empty())
+			{
+				InvalidReference(entity);
+			}
+
+			uint32_t codePoint {};
+			for (char const chr : digits)
 			{
-				size_t const find = value.find(unescaped, startPos);
-				if (find != std::string::npos && find < pos)
+				uint32_t digit {};
+				if (chr >= '0' && chr <= '9')
 				{
-					pos = find;
-					replacement = escaped;
+					digit = static_cast<uint32_t>(chr - '0');
+				}
+				else if (isHex && chr >= 'a' && chr <= 'f')
+				{
+					digit = static_cast<uint32_t>(chr - 'a') + decimal;
+				}
+				else if (isHex && chr >= 'A' && chr <= 'F')
+				{
+					digit = static_cast<uint32_t>(chr - 'A') + decimal;
+				}
+				else
+				{
+					InvalidReference(entity);
+				}
+
+				codePoint = codePoint * (isHex ? hex : decimal) + digit;
+				if (codePoint > maxCodePoint)
+				{
+					InvalidReference(entity);
 				}
 			}
-			if (pos == std::string::npos)
+
+			if (codePoint == 0 || (codePoint >= surrogateFirst && codePoint <= surrogateLast))
 			{
-				out << value.substr(startPos, value.size() - startPos) << replacement;
-				break;
+				InvalidReference(entity);
 			}
-			out << value.substr(startPos, pos - startPos) << replacement;
-			startPos = pos + 1;
+			return codePoint;
 		}
-		return out;
 	}
-}
\ No newline at end of file
+
+	// decodes the standard entities and numeric character references of value into out, which needs value.size() characters
+	// decoding never lengthens the value, other named entities are copied unchanged
+	// returns the end of the decoded value
+	inline char * DecodeTo(std::string_view value, char * out)
+	{
+		for (;;)
+		{
+			size_t const amp = value.find('&');
+			out = std::copy(value.begin(), value.begin() + static_cast<std::ptrdiff_t>(std::min(amp, value.size())), out);
+			if (amp == std::string_view::npos)
+			{
+				return out;
+			}
+			value.remove_prefix(amp);
+
+			size_t const semiColon = value.find(';');
+			if (semiColon == std::string_view::npos)
+			{
+				throw std::runtime_error("Unterminated entity: " + std::string(value));
+			}
+			std::string_view const entity = value.substr(0, semiColon + 1);
+			value.remove_prefix(entity.size());
+
+			if (entity.size() > 2 && entity[1] == '#')
+			{
+				out = Detail::AppendUtf8(Detail::ParseCharacterReference(entity.substr(2, entity.size() - 3), entity), out);
+				continue;
+			}
+
+			auto const known = std::find_if(Entities.begin(), Entities.end(), [&](Entity const & e) { return e.first == entity; });
+			if (known != Entities.end())
+			{
+				*out++ = known->second;
+			}
+			else
+			{
+				out = std::copy(entity.begin(), entity.end(), out);
+			}
+		}
+	}
+
+	// returns value itself when it holds no entities, found with one vectorised scan, otherwise decodes into buffer
+	inline std::string_view Decode(std::string_view const value, std::string & buffer)
+	{
+		char const * const end = value.data() + value.size();
+		if (Scanner::Find(value.data(), end, Scanner::Delimiters<1> {'&'}) == end)
+		{
+			return value;
+		}
+
+		buffer.resize(value.size());
+		buffer.resize(static_cast<size_t>(DecodeTo(value, buffer.data()) - buffer.data()));
+		return buffer;
+	}
+
+	// as above, decoding into caller supplied storage of at least value.size() characters, such as an arena
+	inline std::string_view Decode(std::string_view const value, char * const buffer)
+	{
+		char const * const end = value.data() + value.size();
+		if (Scanner::Find(value.data(), end, Scanner::Delimiters<1> {'&'}) == end)
+		{
+			return value;
+		}
+		return {buffer, static_cast<size_t>(DecodeTo(value, buffer) - buffer)};
+	}
+}